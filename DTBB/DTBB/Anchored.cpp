@@ -174,14 +174,7 @@ void Anchored::Modify(rapidjson::Value const& json_value) {
 }
 
 void Anchored::Link() {
-	auto& go_pool = p_game_obj_manager->GetGameObjectContainer();
-
-	for (auto r = go_pool.all(); not r.is_empty(); r.pop_front()) {
-		GameObject& go_ref = r.front();
-		if (go_ref.GetName().compare(anchored_to_name) == 0) {
-			p_anchored_to_obj = &go_ref;
-		}
-	}
+	p_anchored_to_obj = p_game_obj_manager->FindByName(anchored_to_name);
 
 	if (p_anchored_to_obj == nullptr)
 		return;
@@ -10,6 +10,7 @@
 
 Attachment::Attachment():
 	p_go_attached_to{ nullptr },
+	parented{ false },
 	name_attached_to{},
 	follow{ true },
 	lock_orientation{ true },
@@ -33,20 +34,16 @@ void Attachment::Serialize(rapidjson::Value& json_value, rapidjson::MemoryPoolAl
 }
 
 void Attachment::Link() {
+	UnparentOwner();
+
 	// find game object with matching name
-	auto& game_objs = p_game_obj_manager->GetGameObjectContainer();
-	for (auto range = game_objs.all(); !range.is_empty(); range.pop_front()) {
-		GameObject& game_obj = range.front();
-		if (game_obj.GetName().compare(name_attached_to) == 0) {
-			p_go_attached_to = &game_obj;
-
-			// add this object to holder's list
-			ObjectHolder* p_obj_hold = p_go_attached_to->HasComponent<ObjectHolder>();
-			SIK_ASSERT(p_obj_hold != nullptr, "ObjectHolder does not exist");
-			p_obj_hold->AddAttachment(GetOwner());
-
-			break;
-		}
+	p_go_attached_to = p_game_obj_manager->FindByName(name_attached_to.c_str());
+	if (p_go_attached_to != nullptr) {
+		// add this object to holder's list
+		ObjectHolder* p_obj_hold = p_go_attached_to->HasComponent<ObjectHolder>();
+		SIK_ASSERT(p_obj_hold != nullptr, "ObjectHolder does not exist");
+		p_obj_hold->AddAttachment(GetOwner());
+		ParentOwner();
 	}
 }
 
@@ -63,6 +60,9 @@ void Attachment::OnCollide(GameObject* other)
 }
 
 void Attachment::FixedUpdate(Float32 dt) {
+	// The world matrices carry a parented owner along
+	if (parented) { return; }
+
 	GameObject* p_owner = GetOwner();
 
 	RigidBody* p_owner_rb = p_owner->HasComponent<RigidBody>();
@@ -106,12 +106,14 @@ void Attachment::SetAttachedTo(GameObject* p_attached_to) {
 	if (p_go_attached_to) {
 		ObjectHolder* p_old_obj_hold = p_go_attached_to->HasComponent<ObjectHolder>();
 		p_old_obj_hold->RemoveAttachment(GetOwner());
+		UnparentOwner();
 	}
 
 	// set new object holder
 	p_go_attached_to = p_attached_to;
 	ObjectHolder* p_new_obj_hold = p_go_attached_to->HasComponent<ObjectHolder>();
 	p_new_obj_hold->AddAttachment(GetOwner());
+	ParentOwner();
 }
 
 GameObject* Attachment::GetAttachedTo() {
@@ -134,6 +136,48 @@ Vec3 const& Attachment::GetOffset() {
 	return pos_offset;
 }
 
+Transform Attachment::GetWorldTransform() {
+	GameObject* p_owner = GetOwner();
+	Transform const& owner_transform = *p_owner->HasComponent<Transform>();
+
+	// Also in world space once the parent is deleted, see GameObjectManager
+	GameObject* p_parent = parented ? p_game_obj_manager->Resolve(p_owner->GetParent()) : nullptr;
+	if (p_parent == nullptr) { return owner_transform; }
+
+	return Transform::FromMat4(p_parent->HasComponent<Transform>()->ToMat4() * owner_transform.ToMat4());
+}
+
+// Moves the owner to its offset and makes its Transform relative to the
+// object it is attached to. Owners with a RigidBody are moved by FixedUpdate
+// instead, since physics writes their transform in world space.
+void Attachment::ParentOwner() {
+	GameObject* p_owner = GetOwner();
+	if (not follow || p_go_attached_to == nullptr || p_owner->HasComponent<RigidBody>()) { return; }
+
+	Transform* p_owner_transform = p_owner->HasComponent<Transform>();
+	Transform attached_to_transform = *p_go_attached_to->HasComponent<Transform>();
+
+	Transform world = *p_owner_transform;
+	world.position = attached_to_transform.LocalToWorld(pos_offset);
+	if (lock_orientation) {
+		world.orientation = attached_to_transform.orientation;
+	}
+	*p_owner_transform = Transform::FromMat4(glm::inverse(attached_to_transform.ToMat4()) * world.ToMat4());
+
+	p_owner->SetParent(p_go_attached_to);
+	parented = true;
+}
+
+// Puts the owner back in world space where it is
+void Attachment::UnparentOwner() {
+	if (not parented) { return; }
+
+	Transform const world = GetWorldTransform();
+	*GetOwner()->HasComponent<Transform>() = world;
+	GetOwner()->SetParent(nullptr);
+	parented = false;
+}
+
 BEGIN_ATTRIBUTES_FOR(Attachment)
 DEFINE_MEMBER(Bool, follow)
 DEFINE_MEMBER(Bool, lock_orientation)
@@ -2,6 +2,7 @@
 
 #include "Engine/Component.h"
 #include "Engine/Serializer.h"
+#include "Engine/Transform.h"
 
 // Forward Declaration
 class GameObject;
@@ -32,8 +33,17 @@ public:
 	void SetOffset(Vec3 const& _offset);
 	Vec3 const& GetOffset();
 
+	// Owner's pose in world space. An owner without a RigidBody that follows
+	// is parented to the object it is attached to, see GameObject::SetParent,
+	// so its Transform is relative to that object's.
+	Transform GetWorldTransform();
+
 private:
+	void ParentOwner();
+	void UnparentOwner();
+
 	GameObject* p_go_attached_to;
+	Bool parented;
 
 	// serializable members
 	String name_attached_to;
@@ -7,6 +7,7 @@
 #include "Engine/ParticleSystem.h"
 #include "Engine/RandomGenerator.h"
 #include "Engine/PhysicsManager.h"
+#include "Engine/QueryBatch.h"
 
 #include "CarController.h"
 #include "Health.h"
@@ -50,7 +51,9 @@ BallnChain::BallnChain():
 	anchor_obj{ nullptr },
 	anchor_offset{ 0 },
 	parent_obj_name{},
-	p_emitter{ p_particle_system->NewEmitter() }
+	p_emitter{ p_particle_system->NewEmitter() },
+	seek_query{ QueryBatch::NO_QUERY },
+	seek_target{ nullptr }
 {
 	// emitter settings
 	p_emitter->gravity_scale = 0.0f;
@@ -149,15 +152,7 @@ void BallnChain::Modify(rapidjson::Value const& json_value) {
 }
 
 void BallnChain::Link() {
-	auto& go_pool = p_game_obj_manager->GetGameObjectContainer();
-
-	for (auto r = go_pool.all(); not r.is_empty(); r.pop_front()) {
-		GameObject& go_ref = r.front();
-		if (go_ref.GetName().compare(parent_obj_name) == 0) {
-			p_parent_obj = &go_ref;
-			break;
-		}
-	}
+	p_parent_obj = p_game_obj_manager->FindByName(parent_obj_name);
 	
 	RigidBody* rb = GetOwner()->HasComponent<RigidBody>();
 	if (!(rb && rb->motion_props)) { return; }
@@ -535,46 +530,67 @@ void BallnChain::MoveWreckingBallAwayFromParent(RigidBody* owner_rb, RigidBody*
 }
 
 
-void BallnChain::SeekClosestEnemy(RigidBody* ball_rb) {
-	if (not ball_rb) { return; }
+// True for a car enemy, or a turret base with a live turret on it
+static Bool IsSeekableEnemy(RigidBody const& rb) {
+	if (not rb.owner) { return false; }
 
-	p_physics_manager->ForEachInRadius(8.0f, ball_rb->position, 
-		[ball_rb](RigidBody const& rb) -> Bool {
-			if (not rb.owner || ball_rb->owner == rb.owner) { return true; }
+	if (rb.owner->HasComponent<GenericCarEnemy>()) {
+		return true;
+	}
+	if (ObjectHolder* h = rb.owner->HasComponent<ObjectHolder>(); h) {
+		for (auto&& go : h->GetAttachedObjects()) {
+			if (not go) { continue; }
 
-			Bool found_enemy = false;
-			if (GenericCarEnemy* c = rb.owner->HasComponent<GenericCarEnemy>(); c) {
-				found_enemy = true;
-			}
-			else if (ObjectHolder* h = rb.owner->HasComponent<ObjectHolder>(); h) {
-					auto const& attached = h->GetAttachedObjects();
-					for (auto&& go : attached) {
-						if (not go) { continue; }
-
-						if (TurretEnemy* t = go->HasComponent<TurretEnemy>(); t) {
-							if (t->IsAlive() && not t->IsDying()) {
-								found_enemy = true;
-							}
-						}
-					}
+			if (TurretEnemy* t = go->HasComponent<TurretEnemy>(); t) {
+				if (t->IsAlive() && not t->IsDying()) {
+					return true;
+				}
 			}
+		}
+	}
+	return false;
+}
 
-			if (found_enemy) {
-				if (MotionProperties* mp = ball_rb->motion_props; mp) {
-					Vec3 disp = rb.position - ball_rb->position;
-					Float32 const invD2 = 1.0f / glm::length2(disp);
-					disp *= glm::sqrt(invD2);
+void BallnChain::AddQueries(QueryBatch& batch) {
+	static constexpr Float32 SEEK_RADIUS = 8.0f;
 
-					Float32 const speed2 = glm::length2(mp->linear_velocity);
+	seek_query = QueryBatch::NO_QUERY;
 
-					ball_rb->AddForce(disp * invD2 * speed2 * 100.0f);
-				}
-			}
+	GameObject* ball_obj = GetOwner();
+	if (not (ball_obj && ball_obj->IsActive())) { return; }
 
-			return !found_enemy;
-		});
+	RigidBody* ball_rb = ball_obj->HasComponent<RigidBody>();
+	if (not ball_rb) { return; }
+
+	seek_query = batch.AddSphere(ball_rb->position, SEEK_RADIUS);
+}
 
+void BallnChain::ReadQueries(QueryBatch const& batch) {
+	seek_target = nullptr;
+	if (seek_query == QueryBatch::NO_QUERY) { return; }
 
+	for (QueryBatch::Hit const& hit : batch.Hits(seek_query)) {
+		if (hit.body->owner != GetOwner() && IsSeekableEnemy(*hit.body)) {
+			seek_target = hit.body;
+			return;
+		}
+	}
+}
+
+void BallnChain::SeekClosestEnemy(RigidBody* ball_rb) {
+	RigidBody const* target = seek_target;
+	seek_target = nullptr;
+	if (not (ball_rb && target)) { return; }
+
+	Vec3 disp = target->position - ball_rb->position;
+	Float32 const d2 = glm::length2(disp);
+	if (MotionProperties* mp = ball_rb->motion_props; mp && d2 > 0.0001f) {
+		Float32 const invD2 = 1.0f / d2;
+		disp *= glm::sqrt(invD2);
+
+		Float32 const speed2 = glm::length2(mp->linear_velocity);
+		ball_rb->AddForce(disp * invD2 * speed2 * 100.0f);
+	}
 }
 
 void BallnChain::SetSegmentTransforms() {
@@ -3,6 +3,7 @@
 #include "Engine/Component.h"
 
 class GameObject;
+class QueryBatch;
 struct ParticleEmitter;
 struct RigidBody;
 
@@ -86,6 +87,14 @@ public:
 	*/
 	void Reset() override;
 
+	/*
+	* Adds the query around the ball for enemies to seek, and reads back the
+	* enemy it found. Run in one batch by BaseState::RunSensingQueries.
+	* Returns: void
+	*/
+	void AddQueries(QueryBatch& batch);
+	void ReadQueries(QueryBatch const& batch);
+
 	Vec3 const& GetAnchorOffset();
 	void SetAnchorOffset(Vec3 const& _anchor_offset);
 
@@ -104,6 +113,9 @@ private:
 
 	ParticleEmitter* p_emitter;
 
+	Uint32 seek_query;
+	RigidBody* seek_target;	// enemy found by seek_query, used in the same fixed step
+
 	/*
 	* Calculates and applies spring forces on the "curr_obj"
 	* based on the position and velocities of the "prev_obj" and "next_obj"
@@ -146,7 +158,8 @@ private:
 	void MoveWreckingBallAwayFromParent(RigidBody* owner_rb, RigidBody* parent_rb);
 
 	/*
-	* Applies a small force toward the closest TurretEnemy or GenericCarEnemy
+	* Applies a small force toward the TurretEnemy or GenericCarEnemy found by
+	* seek_query
 	*
 	* Returns: void
 	*/
@@ -6,13 +6,18 @@
 #include "Engine/GameStateManager.h"
 #include "Engine/GameObject.h"
 #include "Engine/GameObjectManager.h"
+#include "Engine/PhysicsManager.h"
 
 #include "BaseState.h"
 #include "GamePlayState.h"
 #include "GarageState.h"
+#include "GenericCarEnemy.h"
+#include "TurretEnemy.h"
+#include "BallnChain.h"
 
 BaseState::BaseState(): 
-	p_player_go{ nullptr }, p_garage_state{ nullptr }, p_gameplay_state{ nullptr } {
+	p_player_go{ nullptr }, p_garage_state{ nullptr }, p_gameplay_state{ nullptr },
+	sensing_queries{}, sensing_objects{} {
 
 	
 }
@@ -52,9 +57,32 @@ void BaseState::Update(Float32 dt) {
 }
 
 void BaseState::FixedUpdate(Float32 fixed_timestep) {
+	RunSensingQueries();
 	GameState::FixedUpdate(fixed_timestep);
 }
 
+void BaseState::RunSensingQueries() {
+	sensing_queries.Clear();
+	sensing_objects.clear();
+	p_game_obj_manager->ForEach([this](GameObject& obj) {
+		Bool senses = false;
+		if (GenericCarEnemy* car = obj.HasComponent<GenericCarEnemy>(); car) { car->AddQueries(sensing_queries); senses = true; }
+		if (TurretEnemy* turret = obj.HasComponent<TurretEnemy>(); turret) { turret->AddQueries(sensing_queries); senses = true; }
+		if (BallnChain* ball = obj.HasComponent<BallnChain>(); ball) { ball->AddQueries(sensing_queries); senses = true; }
+		if (senses) { sensing_objects.push_back(&obj); }
+	});
+
+	p_physics_manager->RunQueries(sensing_queries);
+
+	// Reading hits can destroy objects and spawn drops, so it does not walk the
+	// object pool
+	for (GameObject* obj : sensing_objects) {
+		if (GenericCarEnemy* car = obj->HasComponent<GenericCarEnemy>(); car) { car->ReadQueries(sensing_queries); }
+		if (TurretEnemy* turret = obj->HasComponent<TurretEnemy>(); turret) { turret->ReadQueries(sensing_queries); }
+		if (BallnChain* ball = obj->HasComponent<BallnChain>(); ball) { ball->ReadQueries(sensing_queries); }
+	}
+}
+
 void BaseState::EnableAllObjects() {
 	for (auto& obj : objects_in_current_state) {
 		obj->Enable();
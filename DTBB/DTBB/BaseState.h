@@ -1,5 +1,6 @@
 #pragma once
 #include "Engine/GameState.h"
+#include "Engine/QueryBatch.h"
 
 // forward declarations
 class GameObject;
@@ -54,10 +55,22 @@ public:
 	* Returns: void
 	*/
 	void AddGameObject(GameObject* _p_obj);
+
+	/*
+	* Runs the spatial queries of every enemy and wrecking ball as one batch,
+	* before any object's FixedUpdate. Each type adds its queries, then reads
+	* its hits back once the whole batch has run.
+	* Returns: void
+	*/
+	void RunSensingQueries();
 private:
 	GameObject* p_player_go;
 	GarageState* p_garage_state;
 	GamePlayState* p_gameplay_state;
+
+	// Reused every fixed step to keep their storage
+	QueryBatch sensing_queries;
+	Vector<GameObject*> sensing_objects;
 };
 
 extern BaseState* p_base_state;
\ No newline at end of file
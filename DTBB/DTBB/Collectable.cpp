@@ -9,6 +9,7 @@
 #include "GamePlayState.h"
 
 #include "Engine/GameObject.h"
+#include "Engine/GameObjectManager.h"
 #include "Engine/MotionProperties.h"
 #include "Engine/EasingFunction.h"
 #include "Engine/Serializer.h"
@@ -21,6 +22,8 @@ Collectable::Collectable():
 	is_collected{ false },
 	c_type{ CTypes::Resource1 },
 	elapsed_time{ 0.0f },
+	target_position{ 0.0f },
+	has_target{ false },
 	rising_speed{ 0.0f },
 	chase_speed{ 0.0f },
 	apex_threshold{ 0.0f },
@@ -93,6 +96,13 @@ void Collectable::Disable() {
 	p_emitter->is_active = false;
 }
 
+// Called when the object is recycled, the spawner sets the start height
+void Collectable::Reset() {
+	is_collected = false;
+	elapsed_time = 0.0f;
+	has_target = false;
+}
+
 void Collectable::OnCollide(GameObject* other) {
 
 	// disable collision before it float to the top 
@@ -155,13 +165,20 @@ void Collectable::Update(Float32 dt) {
 		// Hover animation
 		rb->position.y = starting_height + (rising_speed * EasingFunction::EaseOutBounce(elapsed_time / apex_threshold));
 	}
-	else {
+	else if (has_target) {
 		// Follow player
-		RigidBody* player_rb = p_base_state->GetPlayerGameObjPtr()->HasComponent<RigidBody>();
-		if (!player_rb) { return; }
-		Vec3 moveVec = glm::normalize(player_rb->position - rb->position) * chase_speed * (elapsed_time / apex_threshold);
+		Vec3 moveVec = glm::normalize(target_position - rb->position) * chase_speed * (elapsed_time / apex_threshold);
 		rb->motion_props->linear_velocity = moveVec;
 	}
+
+	// Collectables update in parallel, so the player, another object, is
+	// looked up on the main thread once their batch is done
+	p_game_obj_manager->Defer([this] {
+		GameObject* player = p_base_state->GetPlayerGameObjPtr();
+		RigidBody* player_rb = player ? player->HasComponent<RigidBody>() : nullptr;
+		has_target = player_rb != nullptr;
+		if (has_target) { target_position = player_rb->position; }
+	});
 }
 
 void Collectable::SetTrailColor(Vec3 const& color) {
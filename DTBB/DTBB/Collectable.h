@@ -13,6 +13,8 @@ public:
 	};
 
 	VALID_COMPONENT(Collectable);
+	// looks the player up through a deferred command
+	static constexpr Uint16 access = ACCESS_READ_RIGIDBODY | ACCESS_WRITE_RIGIDBODY | ACCESS_READ_GLOBALS;
 	ALLOW_PRIVATE_REFLECTION;
 
 	Collectable();
@@ -23,6 +25,7 @@ public:
 
 	void Enable() override;
 	void Disable() override;
+	void Reset() override;
 
 	void OnCollide(GameObject* other) override;
 	void Update(Float32 dt) override;
@@ -46,6 +49,10 @@ private:
 
 	Float32 elapsed_time;
 
+	// Where the player was at the end of the last update, see Update
+	Vec3 target_position;
+	Bool has_target;
+
 	// Serializable members
 	Float32 rising_speed;
 	Float32 chase_speed;
@@ -8,6 +8,7 @@ CraneEnemy::CraneEnemy():
 	orig_pos{ 0.0f },
 	orig_ori{}
 {
+	SetTickGroup(TickGroup::AI);
 }
 
 CraneEnemy::~CraneEnemy() noexcept
@@ -9,6 +9,7 @@
 #include "BaseState.h"
 #include "ObjectHolder.h"
 #include "Magnet.h"
+#include "PhysicsLayers.h"
 
 #include <algorithm>
 
@@ -23,6 +24,7 @@ Debris::Debris():
 	gravity_scale{ 0.0f },
 	transform_scale{ 0.0f },
 	original_mass{ 0.0f },
+	original_layer{ PhysicsLayer::DEFAULT },
 	chase_speed{ 0.0f },
 	max_chase_dist{ 0.0f }
 {
@@ -73,6 +75,9 @@ void Debris::Link() {
 	if (!(p_rb && p_rb->motion_props)) { return; }
 	gravity_scale = p_rb->motion_props->gravity_scale;
 	original_mass = p_rb->motion_props->mass;
+	if (p_rb->layer != PhysicsLayer::MAGNETIC) {
+		original_layer = p_rb->layer;
+	}
 
 	Transform* p_tr = GetOwner()->HasComponent<Transform>();
 	transform_scale = p_tr->scale;
@@ -132,6 +137,9 @@ void Debris::FixedUpdate(Float32 dt) {
 	Transform* p_tr = GetOwner()->HasComponent<Transform>();
 	if (!(p_rb && p_rb->motion_props)) { return; }
 
+	// ChaseTarget puts it back in the magnet's layer while it is in range
+	p_rb->layer = original_layer;
+
 	if (timer <= 0.0f) {
 		if (not is_stuck) {
 			// chase if magnet has slots
@@ -210,12 +218,15 @@ void Debris::ChaseTarget(Float32 dt) {
 	Float32 length2 = glm::length2(debris_to_target);
 
 	if (length2 < (max_chase_dist * max_chase_dist)) {
-		// scaling value so speed increases as it gets closer to magnet
-		Float32 inv_dist_scale = max_chase_dist * max_chase_dist / length2;
-		inv_dist_scale = std::clamp(inv_dist_scale, 1.0f, 5.0f);
-
-		Vec3 move_vec = glm::normalize(debris_to_target) * chase_speed * inv_dist_scale;
-		p_rb->motion_props->linear_velocity = move_vec;
+		// the magnet's force field pulls it in from here
+		p_rb->layer = PhysicsLayer::MAGNETIC;
+
+		// cap speed so it still gets faster closer to the magnet, up to 5x
+		Float32 max_speed = chase_speed * std::clamp(max_chase_dist * max_chase_dist / length2, 1.0f, 5.0f);
+		Vec3& vel = p_rb->motion_props->linear_velocity;
+		if (glm::length2(vel) > max_speed * max_speed) {
+			vel = glm::normalize(vel) * max_speed;
+		}
 
 		// scale down if moving closer
 		if (glm::all(glm::greaterThan(p_tr->scale, Vec3{ 0.5f }))) {
@@ -57,6 +57,8 @@ private:
 	Vec3 transform_scale;
 	// original mass
 	Float32 original_mass;
+	// original physics layer, left while the magnet is pulling
+	Uint32 original_layer;
 
 	// serializable members
 	Float32 chase_speed;
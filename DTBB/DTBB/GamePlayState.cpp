@@ -10,6 +10,7 @@
 #include "Engine/GameStateManager.h"
 #include "Engine/MemoryManager.h"
 #include "Engine/GameObjectManager.h"
+#include "Engine/Factory.h"
 
 #include "BaseState.h"
 #include "ScriptInterface.h"
@@ -49,6 +50,12 @@ GamePlayState::GamePlayState(const char* scene_json, StringID background_music,
 
 	ResetEnemyCountForHUD();
 
+	// Destroyables drop collectables in bursts, keep them around instead of
+	// building each one
+	p_factory->WarmRecyclePool("CollectableObject.json", 16, 64);
+	// Every turret drops a health pickup when it dies
+	p_factory->WarmRecyclePool("HealthCollectible.json", 4, 16);
+
 	p_pause_state->Exit();
 	p_fade_in->Exit();
 	p_fade_out->Exit();
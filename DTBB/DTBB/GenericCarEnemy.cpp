@@ -3,12 +3,14 @@
 #include "GenericCarEnemy.h"
 
 #include "Engine/GameObject.h"
+#include "Engine/GameObjectManager.h"
 #include "Engine/MotionProperties.h"
 #include "Engine/ParticleSystem.h"
 #include "Engine/ResourceManager.h"
 #include "Engine/MeshRenderer.h"
 #include "Engine/AudioManager.h"
 #include "Engine/GraphicsManager.h"
+#include "Engine/QueryBatch.h"
 
 #include "BaseState.h"
 #include "GamePlayState.h"
@@ -16,6 +18,7 @@
 #include "BallnChain.h"
 #include "Health.h"
 #include "Debris.h"
+#include "PhysicsLayers.h"
 
 GenericCarEnemy::GenericCarEnemy():
 	enemy_type{ EnemyType::SmallCar },
@@ -33,6 +36,8 @@ GenericCarEnemy::GenericCarEnemy():
 	collided_this_frame{ false },
 	player_collision{ false },
 	self_damaging_collision{ false },
+	aggro_query{ QueryBatch::NO_QUERY },
+	target_in_range{ false },
 	orig_pos{ 0.0f },
 	orig_ori{},
 	rand_float{ std::make_unique<UniformRandFloat32>() },
@@ -56,6 +61,8 @@ GenericCarEnemy::GenericCarEnemy():
 	damage{ 0 },
 	destroy_vel_threshold{ 0.0f }
 {
+	// Chasing can run at a lower rate while off-screen
+	SetTickGroup(TickGroup::AI);
 	SetupEmitters();
 }
 
@@ -144,8 +151,7 @@ void GenericCarEnemy::Link() {
 	Behaviour* p_behaviour = GetOwner()->HasComponent<Behaviour>();
 	SIK_ASSERT(p_behaviour != nullptr, "Must have a behaviour.");
 
-	p_behaviour->SetStateVariable(aggro_radius * aggro_radius, "radius_sq");
-	p_behaviour->SetStateVariable(FLT_MAX, "dist_sq");
+	p_behaviour->SetStateVariable(false, "in_range");
 	for (auto& script : p_behaviour->scripts) {
 		script.script_state.set_function("SetAggro", &GenericCarEnemy::SetAggro, this);
 	}
@@ -210,6 +216,7 @@ void GenericCarEnemy::Disable() {
 
 void GenericCarEnemy::Reset() {
 	GameObject* p_owner = GetOwner();
+	target_in_range = false;
 
 	RigidBody* p_rb = p_owner->HasComponent<RigidBody>();
 
@@ -250,9 +257,8 @@ void GenericCarEnemy::Update(Float32 dt) {
 			Vec3 target_pos = target_tr->position;
 			Vec3 final_dir = target_pos - p_transform->position;
 
-			// aggro check
-			Float32 dist_sq = glm::length2(final_dir);
-			p_behaviour->SetStateVariable(dist_sq, "dist_sq");
+			// aggro check, from the sphere query in AddQueries
+			p_behaviour->SetStateVariable(target_in_range, "in_range");
 
 			if (is_aggro) {
 				ChaseTarget(final_dir, dt);
@@ -316,6 +322,21 @@ GenericCarEnemy::EnemyType GenericCarEnemy::GetEnemyType() {
 	return enemy_type;
 }
 
+void GenericCarEnemy::AddQueries(QueryBatch& batch) {
+	aggro_query = QueryBatch::NO_QUERY;
+
+	GameObject* owner = GetOwner();
+	if (not (is_alive && is_chasing && owner && owner->IsActive())) { return; }
+
+	Transform* p_transform = owner->HasComponent<Transform>();
+	aggro_query = batch.AddSphere(p_transform->position, aggro_radius,
+		RigidBody::LayerBit(PhysicsLayer::PLAYER), 1);
+}
+
+void GenericCarEnemy::ReadQueries(QueryBatch const& batch) {
+	target_in_range = aggro_query != QueryBatch::NO_QUERY && not batch.Hits(aggro_query).empty();
+}
+
 void GenericCarEnemy::SetAggro(Bool in_range) {
 	if (is_chasing) {
 		is_aggro = in_range;
@@ -429,7 +450,11 @@ void GenericCarEnemy::ChaseTarget(Vec3 const& final_dir, Float32 dt) {
 	move_angle = glm::clamp(move_angle, -3.142f, 3.142f);
 	p_rigidbody->orientation = Quat(Vec3{ 0.0f, move_angle, 0.0f });;
 
-	p_rigidbody->AddForce(forward_force * local_forward + right_force * local_right);
+	// Off-screen, dt may cover several frames, and the force has to make up
+	// for the frames it was not applied
+	Float32 const frame_dt = p_game_obj_manager->GetTickScheduler().FrameDt();
+	Float32 const frames = frame_dt > 0.0f ? std::max(dt / frame_dt, 1.0f) : 1.0f;
+	p_rigidbody->AddForce((forward_force * local_forward + right_force * local_right) * frames);
 }
 
 Bool GenericCarEnemy::CloseEnough(Vec3 const& loc1, Vec3 const& loc2) {
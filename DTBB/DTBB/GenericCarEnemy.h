@@ -10,6 +10,7 @@ struct LocalLight;
 struct ConeLocalLight;
 struct Transform;
 class GameObject;
+class QueryBatch;
 
 class GenericCarEnemy : public Component {
 public:
@@ -43,6 +44,10 @@ public:
 
 	void SetHeadlights(Bool headlights_on);
 
+	// Aggro query, run in one batch by BaseState::RunSensingQueries
+	void AddQueries(QueryBatch& batch);
+	void ReadQueries(QueryBatch const& batch);
+
 private:
 	void SetAggro(Bool _is_aggro);
 	void ChaseTarget(Vec3 const& final_dir, Float32 dt);
@@ -78,6 +83,9 @@ private:
 	Bool player_collision;
 	Bool self_damaging_collision;
 
+	Uint32 aggro_query;
+	Bool target_in_range;
+
 	Vec3 orig_pos;
 	Quat orig_ori;
 	UniquePtr<RandomGenerator<Float32>> rand_float;
@@ -6,6 +6,7 @@
 class Health : public Component {
 public:
 	VALID_COMPONENT(Health);
+	static constexpr Uint16 access = ACCESS_OWN_DATA;
 	ALLOW_PRIVATE_REFLECTION;
 
 	Health();
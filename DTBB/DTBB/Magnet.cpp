@@ -4,12 +4,14 @@
 
 #include "Engine/GameObject.h"
 #include "Engine/MotionProperties.h"
+#include "Engine/PhysicsManager.h"
 #include "Engine/ScriptingManager.h"
 #include "Engine/AudioManager.h"
 
 #include "Attachment.h"
 #include "BaseState.h"
 #include "Debris.h"
+#include "PhysicsLayers.h"
 
 Magnet::Magnet():
 	attached_debris{},
@@ -18,7 +20,10 @@ Magnet::Magnet():
 	play_loaded_sound{ false },
 	orig_pos{ 0.0f },
 	orig_ori{},
-	shoot_speed{ 0.0f }
+	pull_field{ 0 },
+	shoot_speed{ 0.0f },
+	pull_radius{ 25.0f },
+	pull_acceleration{ 60.0f }
 {
 	attached_debris.reserve(MAX_ATTACHED_DEBRIS);
 
@@ -43,6 +48,7 @@ Magnet::Magnet():
 }
 
 Magnet::~Magnet() noexcept {
+	p_physics_manager->GetForceFields().Remove(pull_field);
 }
 
 void Magnet::Deserialize(rapidjson::Value const& json_value) {
@@ -74,6 +80,21 @@ void Magnet::Link() {
 	RigidBody* p_rb = GetOwner()->HasComponent<RigidBody>();
 	orig_pos = p_rb->position;
 	orig_ori = p_rb->orientation;
+
+	// Link runs again on Enable, and the physics manager drops every field
+	// when it is cleared
+	ForceFieldRegistry& fields = p_physics_manager->GetForceFields();
+	if (fields.Find(pull_field) == nullptr) {
+		pull_field = fields.Add(ForceField{
+			.type = ForceField::Type::Radial,
+			.falloff = ForceFalloff::Constant,
+			.center = p_rb->position,
+			.radius = pull_radius,
+			.strength = -pull_acceleration,
+			.scale_by_mass = true,
+			.layer_mask = RigidBody::LayerBit(PhysicsLayer::MAGNETIC)
+		});
+	}
 }
 
 void Magnet::Enable() {
@@ -82,6 +103,9 @@ void Magnet::Enable() {
 
 void Magnet::Disable() {
 	p_audio_manager->Stop(sound_id);
+
+	p_physics_manager->GetForceFields().Remove(pull_field);
+	pull_field = 0;
 }
 
 void Magnet::Reset() {
@@ -110,6 +134,10 @@ void Magnet::FixedUpdate(Float32 dt) {
 	SIK_ASSERT(rb != nullptr && mp != nullptr, "Magnet needs rigidbody");
 	if (!rb || !mp) { return; }
 
+	if (ForceField* field = p_physics_manager->GetForceFields().Find(pull_field); field) {
+		field->center = rb->position;
+	}
+
 	for (Uint8 i = 0; i < num_attached_debris; ++i) {
 		Debris* debris = std::get<1>(attached_debris[i]);
 
@@ -207,4 +235,6 @@ void Magnet::PlayLoadedSound(Bool _play_loaded_sound) {
 
 BEGIN_ATTRIBUTES_FOR(Magnet)
 	DEFINE_MEMBER(Float32, shoot_speed)
+	DEFINE_MEMBER(Float32, pull_radius)
+	DEFINE_MEMBER(Float32, pull_acceleration)
 END_ATTRIBUTES
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Engine/Component.h"
 #include "Engine/Serializer.h"
+#include "Engine/ForceGenerators.h"
 
 // forward declaration
 class Debris;
@@ -56,6 +57,11 @@ private:
 	Vec3 orig_pos;
 	Quat orig_ori;
 
+	// pulls debris on PhysicsLayer::MAGNETIC in, see Debris::ChaseTarget
+	ForceFieldID pull_field;
+
 	// serializable members
 	Float32 shoot_speed;
+	Float32 pull_radius;		// covers the largest Debris::max_chase_dist
+	Float32 pull_acceleration;
 };
\ No newline at end of file
@@ -6,6 +6,7 @@
 class Ocean : public Component {
 public:
 	VALID_COMPONENT(Ocean);
+	static constexpr Uint16 access = ACCESS_READ_TRANSFORM | ACCESS_WRITE_TRANSFORM;
 	ALLOW_PRIVATE_REFLECTION;
 
 	Ocean();
@@ -0,0 +1,9 @@
+#pragma once
+
+// RigidBody::layer values used by the game. Force fields and batched queries
+// filter bodies with masks of these, see RigidBody::LayerBit.
+namespace PhysicsLayer {
+	constexpr Uint32 DEFAULT = 0;
+	constexpr Uint32 MAGNETIC = 1;	// debris the player's magnet is pulling in
+	constexpr Uint32 PLAYER = 2;	// the player's car, which enemies' aggro queries look for
+}
@@ -5,6 +5,7 @@
 #include "BaseState.h"
 #include "Health.h"
 #include "CarController.h"
+#include "PhysicsLayers.h"
 
 #include "Engine/GameObject.h"
 #include "Engine/ParticleSystem.h"
@@ -137,6 +138,10 @@ void PlayerCharacter::Modify(rapidjson::Value const& json_value) {
 
 
 void PlayerCharacter::Link() {
+	// enemies' aggro queries only look at this layer
+	if (RigidBody* rb = GetOwner()->HasComponent<RigidBody>(); rb) {
+		rb->layer = PhysicsLayer::PLAYER;
+	}
 }
 
 void PlayerCharacter::Enable() {
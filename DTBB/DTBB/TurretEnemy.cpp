@@ -14,6 +14,7 @@
 #include "Engine/ResourceManager.h"
 #include "Engine/GraphicsManager.h"
 #include "Engine/MeshRenderer.h"
+#include "Engine/QueryBatch.h"
 
 #include "Health.h"
 #include "BallnChain.h"
@@ -24,6 +25,8 @@
 #include "Destroyable.h"
 #include "ObjectHolder.h"
 #include "Debris.h"
+#include "PhysicsLayers.h"
+#include "Attachment.h"
 
 TurretEnemy::TurretEnemy() :
 	p_target{ nullptr },
@@ -37,6 +40,10 @@ TurretEnemy::TurretEnemy() :
 	is_aggro{ false },
 	collided_last_frame{ false },
 	collided_this_frame{ false },
+	aggro_query{ QueryBatch::NO_QUERY },
+	explosion_query{ QueryBatch::NO_QUERY },
+	target_in_range{ false },
+	explosion_pending{ false },
 	dead_particles_timer{ 0.0f },
 	spark_particles_timer{ 0.0f },
 	invulnerability_timer{ 1.0f },
@@ -49,6 +56,8 @@ TurretEnemy::TurretEnemy() :
 	light_col{ 0.0f },
 	explosion_radius{ 15.0f }
 {
+	// Aiming and shooting can run at a lower rate while off-screen
+	SetTickGroup(TickGroup::AI);
 	SetupParticleEmitters();
 }
 
@@ -74,19 +83,12 @@ void TurretEnemy::Serialize(rapidjson::Value& json_value, rapidjson::MemoryPoolA
 
 void TurretEnemy::Link() {
 	// get target game object ptr
-	auto& go_pool = p_game_obj_manager->GetGameObjectContainer();
-	for (auto r = go_pool.all(); not r.is_empty(); r.pop_front()) {
-		GameObject& go_ref = r.front();
-		if (go_ref.GetName().compare(target_name) == 0) {
-			p_target = &go_ref;
-		}
-	}
+	p_target = p_game_obj_manager->FindByName(target_name);
 
 	// scripts
 	Behaviour* p_behaviour = GetOwner()->HasComponent<Behaviour>();
 
-	p_behaviour->SetStateVariable(aggro_radius * aggro_radius, "radius_sq");
-	p_behaviour->SetStateVariable(FLT_MAX, "dist_sq");
+	p_behaviour->SetStateVariable(false, "in_range");
 	for (auto& script : p_behaviour->scripts) {
 		script.script_state.set_function("SetAggro", &TurretEnemy::SetAggro, this);
 	}
@@ -130,6 +132,7 @@ void TurretEnemy::Update(Float32 dt) {
 	GameObject* owner = GetOwner();
 	Behaviour* p_behaviour = owner->HasComponent<Behaviour>();
 	Transform* p_tr = owner->HasComponent<Transform>();
+	Transform world_tr = WorldPose(); // the Transform is relative to the turret base
 
 	if ( IsDying() ) {
 		death_timer -= dt;
@@ -138,9 +141,9 @@ void TurretEnemy::Update(Float32 dt) {
 		}
 	}
 
-	// Light position needs to be set here because
-	// the Attachment comp only updates the transform in Update()
-	p_light->position = p_tr->position;
+	// Light position needs to be set here because the Attachment
+	// comp only parents the turret to its base once linked
+	p_light->position = world_tr.position;
 	p_light->position.y += 1.0f;
 	//p_light->position.y = -1.0f;
 
@@ -173,8 +176,8 @@ void TurretEnemy::Update(Float32 dt) {
 					p_turret_emitter->particles_per_sec = 1.0f / secs_per_bullet;
 
 					// enable smoke
-					p_smoke_emitter->position = p_tr->LocalToWorld(Vec3{ 0.0f, p_tr->scale.y, 0.0f });
-					p_smoke_emitter->orientation = p_tr->orientation;
+					p_smoke_emitter->position = world_tr.LocalToWorld(Vec3{ 0.0f, world_tr.scale.y, 0.0f });
+					p_smoke_emitter->orientation = world_tr.orientation;
 					p_smoke_emitter->is_active = true;
 
 					// damaged model
@@ -183,8 +186,8 @@ void TurretEnemy::Update(Float32 dt) {
 				}
 
 				// hit emitter
-				p_hit_emitter->position = p_tr->position;
-				p_hit_emitter->orientation = p_tr->orientation;
+				p_hit_emitter->position = world_tr.position;
+				p_hit_emitter->orientation = world_tr.orientation;
 				p_hit_emitter->EmitParticles(15);
 			}
 		}
@@ -202,7 +205,7 @@ void TurretEnemy::Update(Float32 dt) {
 			Transform* p_target_tr = p_target->HasComponent<Transform>();
 			Vec3 target_pos = p_target_tr->position;
 
-			Vec3 turret_to_target = target_pos - p_tr->position;
+			Vec3 turret_to_target = target_pos - world_tr.position;
 
 			p_turret_emitter->is_active = is_aggro;
 			if (is_aggro) {
@@ -213,7 +216,7 @@ void TurretEnemy::Update(Float32 dt) {
 				Vec3 final_dir = turret_to_target;
 				final_dir.y = 0.0f;
 				final_dir = glm::normalize(final_dir);
-				Vec3 curr_dir = glm::normalize(p_tr->orientation * Vec3{ 0.0f, 0.0f, -1.0f });
+				Vec3 curr_dir = glm::normalize(world_tr.orientation * Vec3{ 0.0f, 0.0f, -1.0f });
 
 				Float32 y_angle = glm::angle(final_dir, glm::normalize(turret_to_target));
 
@@ -230,9 +233,10 @@ void TurretEnemy::Update(Float32 dt) {
 				Float32 x_angle = atan2f(det, dot);
 
 				p_tr->orientation = glm::rotate(p_tr->orientation, x_angle * dt * 2.0f, Vec3{ 0.0f, 1.0f, 0.0f });
+				world_tr.orientation = glm::rotate(world_tr.orientation, x_angle * dt * 2.0f, Vec3{ 0.0f, 1.0f, 0.0f });
 
-				p_turret_emitter->position = p_tr->position + (curr_dir * p_tr->scale.z * 2.0f);
-				p_turret_emitter->orientation = p_tr->orientation;
+				p_turret_emitter->position = world_tr.position + (curr_dir * world_tr.scale.z * 2.0f);
+				p_turret_emitter->orientation = world_tr.orientation;
 
 				// spark emitters
 				if (spark_particles_timer > secs_per_bullet) {
@@ -245,7 +249,7 @@ void TurretEnemy::Update(Float32 dt) {
 						0);
 
 					p_spark_emitter->position = p_turret_emitter->position;
-					p_spark_emitter->orientation = p_tr->orientation;
+					p_spark_emitter->orientation = world_tr.orientation;
 					p_spark_emitter->EmitParticles(10);
 
 					spark_particles_timer = 0.0f;
@@ -256,12 +260,11 @@ void TurretEnemy::Update(Float32 dt) {
 				p_light->color = light_col;
 			}
 
-			// aggro check
-			Float32 dist_sq = glm::length2(turret_to_target);
-			p_behaviour->SetStateVariable(dist_sq, "dist_sq");
+			// aggro check, from the sphere query in AddQueries
+			p_behaviour->SetStateVariable(target_in_range, "in_range");
 
 			/*
-			* script compares dist_sq and radius_sq and set aggro state
+			* script sets aggro state from in_range
 			*/
 		}
 
@@ -283,8 +286,8 @@ void TurretEnemy::Update(Float32 dt) {
 		// once every 0.8 secs
 		if (dead_particles_timer > 0.8f) {
 			// death emitter
-			p_spark_emitter->position = p_tr->position;
-			p_spark_emitter->orientation = p_tr->orientation;
+			p_spark_emitter->position = world_tr.position;
+			p_spark_emitter->orientation = world_tr.orientation;
 			p_spark_emitter->EmitParticles(15);
 
 			dead_particles_timer = 0.0f;
@@ -337,6 +340,8 @@ void TurretEnemy::Enable() {
 
 void TurretEnemy::Reset() {
 	is_alive = true;
+	target_in_range = false;
+	explosion_pending = false;
 	//Restore the turret health
 	GameObject* p_owner = GetOwner();
 
@@ -377,7 +382,7 @@ void TurretEnemy::SayGoodbyeAndDie() {
 	// Fetch owner data
 	GameObject* owner = GetOwner();
 	if (not owner) { return; }
-	Transform* tr = owner->HasComponent<Transform>();
+	Transform world_tr = WorldPose();
 
 	// change model
 	MeshRenderer* mr = owner->HasComponent<MeshRenderer>();
@@ -387,18 +392,18 @@ void TurretEnemy::SayGoodbyeAndDie() {
 	p_light->enabled = false;
 
 	// enable smoke
-	p_smoke_emitter->position = tr->LocalToWorld(Vec3{ 0.0f, tr->scale.y, 0.0f });
-	p_smoke_emitter->orientation = tr->orientation;
+	p_smoke_emitter->position = world_tr.LocalToWorld(Vec3{ 0.0f, world_tr.scale.y, 0.0f });
+	p_smoke_emitter->orientation = world_tr.orientation;
 	p_smoke_emitter->is_active = true;
 
 	// enable flame
-	p_flame_emitter->position = tr->LocalToWorld(Vec3{ 0.0f, tr->scale.y, 0.0f });
-	p_flame_emitter->orientation = tr->orientation;
+	p_flame_emitter->position = world_tr.LocalToWorld(Vec3{ 0.0f, world_tr.scale.y, 0.0f });
+	p_flame_emitter->orientation = world_tr.orientation;
 	p_flame_emitter->is_active = true;
 
 	// Emit explosion particles
-	p_death_emitter->position = tr->position;
-	p_death_emitter->orientation = tr->orientation;
+	p_death_emitter->position = world_tr.position;
+	p_death_emitter->orientation = world_tr.orientation;
 	p_death_emitter->EmitParticles(512);
 
 	// Spawn Health Collectible object here
@@ -408,7 +413,7 @@ void TurretEnemy::SayGoodbyeAndDie() {
 		Collectable* col = p_col_obj->HasComponent<Collectable>();
 
 		if (col_rb && col) {
-			col_rb->position = tr->position;
+			col_rb->position = world_tr.position;
 			col_rb->Enable(true);
 
 			col->SetStartHeight(col_rb->position.y);
@@ -418,45 +423,78 @@ void TurretEnemy::SayGoodbyeAndDie() {
 		p_base_state->GetGamePlayState()->AddObject(p_col_obj);
 	}
 
-	// Destroy neighboring turrets and destroyables
-	p_physics_manager->ForEachInRadius(explosion_radius, tr->position, 
-		[owner](RigidBody const& rb) -> Bool {
-			if (not rb.owner || rb.owner == owner) { return true; }
+	// Destroy neighboring turrets and destroyables, see ReadQueries
+	explosion_pending = true;
+}
 
-			if (TurretEnemy* other_turret = rb.owner->HasComponent<TurretEnemy>(); other_turret) {
-				if (other_turret->IsAlive() && not other_turret->IsDying()) { // check to avoid infinite loops!
-					other_turret->SetDeathTimer(0.5f);
-				}
-			}
-			
-			if (Destroyable* other_destroyable = rb.owner->HasComponent<Destroyable>(); other_destroyable) {
-				other_destroyable->SayGoodbyeAndDie();
-			}
+void TurretEnemy::AddQueries(QueryBatch& batch) {
+	aggro_query = QueryBatch::NO_QUERY;
+	explosion_query = QueryBatch::NO_QUERY;
+
+	GameObject* owner = GetOwner();
+	if (not (owner && owner->IsActive())) { return; }
+	Vec3 const position = WorldPose().position;
+
+	if (is_alive) {
+		aggro_query = batch.AddSphere(position, aggro_radius,
+			RigidBody::LayerBit(PhysicsLayer::PLAYER), 1);
+	}
+	if (explosion_pending) {
+		explosion_query = batch.AddSphere(position, explosion_radius);
+	}
+}
 
-			// TODO: remove this if possible. This is needed for now because Turrets 
-			// are weird... Adding a RigidBody to them in the JSON resulted in strange 
-			// behavior in the scene (things spawned in incorrect locations, collisions
-			// failed to happen, etc.)
-			ObjectHolder* other_holder = rb.owner->HasComponent<ObjectHolder>();
-			if (other_holder) {
-				auto const& attached = other_holder->GetAttachedObjects();
-				for (auto&& go : attached) {
-					if (not go) { continue; }
-
-					if (TurretEnemy* t = go->HasComponent<TurretEnemy>(); t) {
-						if (t->IsAlive() && not t->IsDying()) { // check to avoid infinite loops!
-							t->SetDeathTimer(0.5f);
-						}
-					}
-					if (Destroyable* d = go->HasComponent<Destroyable>(); d) {
-						d->SayGoodbyeAndDie();
-					}
+void TurretEnemy::ReadQueries(QueryBatch const& batch) {
+	target_in_range = aggro_query != QueryBatch::NO_QUERY && not batch.Hits(aggro_query).empty();
+
+	if (explosion_query != QueryBatch::NO_QUERY) {
+		explosion_pending = false;
+		for (QueryBatch::Hit const& hit : batch.Hits(explosion_query)) {
+			DestroyNeighbor(*hit.body);
+		}
+	}
+}
+
+// Turrets are parented to their base by the Attachment comp
+Transform TurretEnemy::WorldPose() {
+	GameObject* owner = GetOwner();
+	Attachment* p_attachment = owner->HasComponent<Attachment>();
+	return p_attachment ? p_attachment->GetWorldTransform() : *owner->HasComponent<Transform>();
+}
+
+void TurretEnemy::DestroyNeighbor(RigidBody const& rb) {
+	if (not rb.owner || rb.owner == GetOwner()) { return; }
+
+	if (TurretEnemy* other_turret = rb.owner->HasComponent<TurretEnemy>(); other_turret) {
+		if (other_turret->IsAlive() && not other_turret->IsDying()) { // check to avoid infinite loops!
+			other_turret->SetDeathTimer(0.5f);
+		}
+	}
+	
+	if (Destroyable* other_destroyable = rb.owner->HasComponent<Destroyable>(); other_destroyable) {
+		other_destroyable->SayGoodbyeAndDie();
+	}
+
+	// TODO: remove this if possible. This is needed for now because Turrets 
+	// are weird... Adding a RigidBody to them in the JSON resulted in strange 
+	// behavior in the scene (things spawned in incorrect locations, collisions
+	// failed to happen, etc.)
+	ObjectHolder* other_holder = rb.owner->HasComponent<ObjectHolder>();
+	if (other_holder) {
+		auto const& attached = other_holder->GetAttachedObjects();
+		for (auto&& go : attached) {
+			if (not go) { continue; }
+
+			if (TurretEnemy* t = go->HasComponent<TurretEnemy>(); t) {
+				if (t->IsAlive() && not t->IsDying()) { // check to avoid infinite loops!
+					t->SetDeathTimer(0.5f);
 				}
 			}
-
-			return true;
+			if (Destroyable* d = go->HasComponent<Destroyable>(); d) {
+				d->SayGoodbyeAndDie();
+			}
 		}
-	);
+	}
 }
 
 void TurretEnemy::SetupParticleEmitters() {
@@ -2,9 +2,12 @@
 
 #include "Engine/Component.h"
 #include "Engine/Serializer.h"
+#include "Engine/Transform.h"
 
 // forward declarations
 class GameObject;
+class QueryBatch;
+struct RigidBody;
 struct ParticleEmitter;
 struct LocalLight;
 
@@ -33,10 +36,18 @@ public:
 	void Enable() override;
 	void Reset() override;
 
+	// Aggro and explosion queries, run in one batch by BaseState::RunSensingQueries
+	void AddQueries(QueryBatch& batch);
+	void ReadQueries(QueryBatch const& batch);
+
 private:
 	void SetAggro(Bool _is_aggro);
 	void SayGoodbyeAndDie();
 	void SetupParticleEmitters();
+	// destroys the turrets and destroyables of a body caught in the explosion
+	void DestroyNeighbor(RigidBody const& rb);
+	// pose in world space, the Transform is relative to the turret base
+	Transform WorldPose();
 
 private:
 	GameObject* p_target;
@@ -52,6 +63,11 @@ private:
 	Bool collided_last_frame;
 	Bool collided_this_frame;
 
+	Uint32 aggro_query;
+	Uint32 explosion_query;
+	Bool target_in_range;
+	Bool explosion_pending;	// neighbors are destroyed on the next sensing pass
+
 	Float32 dead_particles_timer;
 	Float32 spark_particles_timer;
 	Float32 invulnerability_timer;
@@ -0,0 +1,306 @@
+#include "stdafx.h"
+#include "AllocationAudit.h"
+
+#include "MemoryResources.h"
+
+#include <atomic>
+#include <mutex>
+
+#ifdef ALLOC_AUDIT
+#include <Windows.h>
+#include <DbgHelp.h>
+#pragma comment(lib, "dbghelp.lib")
+#endif
+
+static constexpr SizeT MAX_WATCHED = 8;
+static Array<DebugMemoryResource*, MAX_WATCHED> watched{};
+
+void AllocationAudit::Watch(DebugMemoryResource* resource) {
+	auto it = std::find(watched.begin(), watched.end(), nullptr);
+	SIK_ASSERT(it != watched.end(), "Too many resources watched by the allocation audit.");
+	if (it != watched.end()) {
+		*it = resource;
+	}
+}
+
+void AllocationAudit::Unwatch(DebugMemoryResource* resource) {
+	std::replace(watched.begin(), watched.end(), resource, static_cast<DebugMemoryResource*>(nullptr));
+}
+
+#ifdef ALLOC_AUDIT
+
+////////////////////////////////////////////////////////////////////////////////
+// State
+////////////////////////////////////////////////////////////////////////////////
+// Everything here is constant-initialized, since operator new may be called
+// before main. Nothing here may allocate from the heap.
+
+struct Callsite {
+	ULONG   hash = 0;	// from CaptureStackBackTrace, 0 for an empty slot
+	Uint32  samples = 0;
+	Uint64  bytes = 0;
+	Uint32  depth = 0;
+	void*   frames[AllocationAudit::STACK_DEPTH] = {};
+};
+
+static std::atomic<Uint64> frame_allocations{ 0 };
+static std::atomic<Uint64> frame_frees{ 0 };
+static std::atomic<Uint64> frame_bytes{ 0 };
+static std::atomic<Uint32> frame_index{ 1 };
+static std::atomic<Uint32> frame_first_sampled{ 0 };		// frame_index whose first allocation was sampled
+static std::atomic<AllocationAudit::Mode> mode{ AllocationAudit::Mode::Off };
+static std::atomic<Uint32> warmup_remaining{ 120 };
+
+static std::mutex callsites_mtx;							// guards everything below
+static Array<Callsite, AllocationAudit::MAX_CALLSITES> callsites{};
+static Uint32 used_callsites = 0;							// so FrameEnd only clears a table which was written
+static Uint32 dropped_samples = 0;
+static AllocationAudit::FrameCounts last_frame{};
+
+// Set while the audit itself runs, so its own allocations (e.g. logging) are
+// not counted, and so sampling never recurses
+static thread_local Bool in_audit = false;
+static thread_local Uint32 sample_countdown = AllocationAudit::SAMPLE_RATE;
+
+////////////////////////////////////////////////////////////////////////////////
+// Sampling
+////////////////////////////////////////////////////////////////////////////////
+
+static void SampleCallsite(SizeT bytes) noexcept {
+	void* frames[AllocationAudit::STACK_DEPTH];
+	ULONG hash = 0;
+	USHORT const depth = CaptureStackBackTrace(1, AllocationAudit::STACK_DEPTH, frames, &hash);
+	hash = hash == 0 ? 1 : hash;
+
+	std::scoped_lock lock{ callsites_mtx };
+
+	// Open addressing, so a frame's table never needs to grow
+	for (Uint32 probe = 0; probe < AllocationAudit::MAX_CALLSITES; ++probe) {
+		Callsite& site = callsites[(hash + probe) % AllocationAudit::MAX_CALLSITES];
+		if (site.hash == 0) {
+			++used_callsites;
+			site.hash = hash;
+			site.depth = depth;
+			std::copy_n(frames, depth, site.frames);
+		}
+		if (site.hash == hash) {
+			++site.samples;
+			site.bytes += bytes;
+			return;
+		}
+	}
+	++dropped_samples;
+}
+
+void AllocationAudit::RecordAllocation(SizeT bytes) noexcept {
+	if (in_audit) { return; }
+
+	frame_allocations.fetch_add(1, std::memory_order_relaxed);
+	frame_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+	if (mode.load(std::memory_order_relaxed) == Mode::Off) { return; }
+
+	// Always sample a frame's first allocation, so a frame with a single stray
+	// allocation still shows where it came from
+	Uint32 const frame = frame_index.load(std::memory_order_relaxed);
+	Bool const first = frame_first_sampled.load(std::memory_order_relaxed) != frame
+		&& frame_first_sampled.exchange(frame, std::memory_order_relaxed) != frame;
+
+	if (first || --sample_countdown == 0) {
+		sample_countdown = SAMPLE_RATE;
+		in_audit = true;
+		SampleCallsite(bytes);
+		in_audit = false;
+	}
+}
+
+void AllocationAudit::RecordFree() noexcept {
+	if (in_audit) { return; }
+	frame_frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Reporting
+////////////////////////////////////////////////////////////////////////////////
+
+// Frames inside the allocator itself say nothing about who allocated
+static Bool IsAllocatorFrame(const char* name) {
+	return std::strncmp(name, "std::", 5) == 0
+		|| std::strncmp(name, "operator new", 12) == 0
+		|| std::strncmp(name, "AllocationAudit::", 17) == 0
+		|| std::strncmp(name, "DebugMemoryResource::", 21) == 0;
+}
+
+static void LogCallsite(Callsite const& site) {
+	static Bool sym_initialized = false;
+	HANDLE const process = GetCurrentProcess();
+	if (not sym_initialized) {
+		SymSetOptions(SymGetOptions() | SYMOPT_LOAD_LINES | SYMOPT_UNDNAME);
+		sym_initialized = SymInitialize(process, nullptr, TRUE);
+	}
+
+	alignas(SYMBOL_INFO) char buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME];
+	SYMBOL_INFO* const symbol = reinterpret_cast<SYMBOL_INFO*>(buffer);
+
+	// Print the first frame outside of the allocator, and its caller
+	Uint32 printed = 0;
+	for (Uint32 i = 0; i < site.depth && printed < 2; ++i) {
+		DWORD64 const address = reinterpret_cast<DWORD64>(site.frames[i]);
+
+		std::memset(buffer, 0, sizeof(buffer));
+		symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+		symbol->MaxNameLen = MAX_SYM_NAME;
+		if (not sym_initialized || not SymFromAddr(process, address, nullptr, symbol)) {
+			SIK_WARN("\t\t{}", site.frames[i]);
+			++printed;
+			continue;
+		}
+		if (printed == 0 && IsAllocatorFrame(symbol->Name)) { continue; }
+
+		IMAGEHLP_LINE64 line{ .SizeOfStruct = sizeof(IMAGEHLP_LINE64) };
+		DWORD displacement = 0;
+		if (SymGetLineFromAddr64(process, address, &displacement, &line)) {
+			SIK_WARN("\t\t{} ({}:{})", symbol->Name, line.FileName, line.LineNumber);
+		}
+		else {
+			SIK_WARN("\t\t{}", symbol->Name);
+		}
+		++printed;
+	}
+}
+
+static void Report(AllocationAudit::FrameCounts const& counts, Uint32 frame) {
+	SIK_WARN("Frame {} allocated {} times ({} bytes) after warmup.", frame, counts.allocations, counts.bytes);
+
+	for (DebugMemoryResource* resource : watched) {
+		if (resource && resource->FrameAllocations() > 0) {
+			SIK_WARN("\t{} through \"{}\" ({} bytes)", resource->FrameAllocations(), resource->Name(), resource->FrameBytes());
+		}
+	}
+
+	// Top callsites by samples. The table is only touched under its lock, and
+	// this runs at frame end, so partial_sort in place is fine.
+	auto const used_end = std::partition(callsites.begin(), callsites.end(), [](Callsite const& c) { return c.hash != 0; });
+	Uint32 const used = static_cast<Uint32>(used_end - callsites.begin());
+	Uint32 const top = std::min(used, AllocationAudit::TOP_CALLSITES);
+	std::partial_sort(callsites.begin(), callsites.begin() + top, used_end,
+		[](Callsite const& a, Callsite const& b) { return a.samples > b.samples; });
+
+	for (Uint32 i = 0; i < top; ++i) {
+		SIK_WARN("\t{} sampled ({} bytes):", callsites[i].samples, callsites[i].bytes);
+		LogCallsite(callsites[i]);
+	}
+	if (dropped_samples > 0) {
+		SIK_WARN("\t{} samples dropped, callsite table was full.", dropped_samples);
+	}
+}
+
+void AllocationAudit::FrameEnd() {
+	in_audit = true;
+
+	FrameCounts const counts{
+		.allocations = frame_allocations.exchange(0, std::memory_order_relaxed),
+		.frees = frame_frees.exchange(0, std::memory_order_relaxed),
+		.bytes = frame_bytes.exchange(0, std::memory_order_relaxed)
+	};
+
+	std::scoped_lock lock{ callsites_mtx };
+	last_frame = counts;
+
+	Uint32 const frame = frame_index.load(std::memory_order_relaxed);
+	Mode const current_mode = mode.load(std::memory_order_relaxed);
+	if (warmup_remaining.load(std::memory_order_relaxed) > 0) {
+		warmup_remaining.fetch_sub(1, std::memory_order_relaxed);
+	}
+	else if (current_mode != Mode::Off && counts.allocations > 0) {
+		Report(counts, frame);
+		if (current_mode == Mode::Assert) {
+			SIK_CRITICAL("Frame {} allocated after warmup.", frame);
+			SIK_BREAK
+		}
+	}
+
+	for (DebugMemoryResource* resource : watched) {
+		if (resource) { resource->ResetFrameCounts(); }
+	}
+	if (used_callsites > 0) {
+		callsites.fill(Callsite{});
+		used_callsites = 0;
+	}
+	dropped_samples = 0;
+	frame_index.fetch_add(1, std::memory_order_relaxed);
+
+	in_audit = false;
+}
+
+void AllocationAudit::SetMode(Mode new_mode) noexcept {
+	mode.store(new_mode, std::memory_order_relaxed);
+}
+
+AllocationAudit::Mode AllocationAudit::GetMode() noexcept {
+	return mode.load(std::memory_order_relaxed);
+}
+
+void AllocationAudit::Rearm(Uint32 warmup_frames) noexcept {
+	warmup_remaining.store(warmup_frames, std::memory_order_relaxed);
+}
+
+AllocationAudit::FrameCounts AllocationAudit::LastFrame() noexcept {
+	std::scoped_lock lock{ callsites_mtx };
+	return last_frame;
+}
+
+Bool AllocationAudit::IsEnabled() noexcept {
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Global new and delete
+////////////////////////////////////////////////////////////////////////////////
+// Only the four base forms are replaced: the array, nothrow and sized forms
+// forward to these.
+
+void* operator new(std::size_t size) {
+	AllocationAudit::RecordAllocation(size);
+	if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+		return ptr;
+	}
+	throw std::bad_alloc{};
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	AllocationAudit::RecordAllocation(size);
+	if (void* ptr = _aligned_malloc(size == 0 ? 1 : size, static_cast<std::size_t>(alignment))) {
+		return ptr;
+	}
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+	if (ptr == nullptr) { return; }
+	AllocationAudit::RecordFree();
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+	if (ptr == nullptr) { return; }
+	AllocationAudit::RecordFree();
+	_aligned_free(ptr);
+}
+
+#else
+
+void AllocationAudit::SetMode(Mode) noexcept {}
+AllocationAudit::Mode AllocationAudit::GetMode() noexcept { return Mode::Off; }
+void AllocationAudit::Rearm(Uint32) noexcept {}
+void AllocationAudit::RecordAllocation(SizeT) noexcept {}
+void AllocationAudit::RecordFree() noexcept {}
+void AllocationAudit::FrameEnd() {
+	for (DebugMemoryResource* resource : watched) {
+		if (resource) { resource->ResetFrameCounts(); }
+	}
+}
+AllocationAudit::FrameCounts AllocationAudit::LastFrame() noexcept { return {}; }
+Bool AllocationAudit::IsEnabled() noexcept { return false; }
+
+#endif
@@ -0,0 +1,73 @@
+#pragma once
+
+class DebugMemoryResource;
+
+/*
+* Finds heap allocations in frames which should not allocate at all.
+*
+* When ALLOC_AUDIT is defined, global operator new and delete are replaced to
+* count every allocation made on any thread. While the mode is not Off, each
+* frame's first allocation and every SAMPLE_RATE-th one after it also record
+* their callstack. FrameEnd, called at the end of every frame of the main loop,
+* closes the frame's counts. Once the warmup frames are over, a frame which
+* allocated is reported along with its most common sampled callsites, and in
+* Mode::Assert it also breaks into the debugger.
+*
+* Counting is two relaxed atomic increments per allocation, cheap enough to
+* leave on in every Debug run. Only Debug defines ALLOC_AUDIT: reports go
+* through SIK_WARN, which Release (SIK_LOG_LEVEL=0) compiles out. Without
+* ALLOC_AUDIT, every function here still exists but does nothing.
+*
+* Typical use: turn on Report mode, play through a level, then remove the
+* std::function, String and Vector allocations that show up in update loops.
+* Call Rearm after loading a level so its allocations are not reported.
+*/
+class AllocationAudit {
+public:
+	enum class Mode : Uint32 {
+		Off = 0,	// only count
+		Report,		// log frames which allocate after warmup, with their top callsites
+		Assert		// as Report, then break
+	};
+
+	static constexpr Uint32 SAMPLE_RATE = 64;		// one in SAMPLE_RATE allocations records its callstack
+	static constexpr Uint32 MAX_CALLSITES = 512;	// distinct callstacks kept per frame
+	static constexpr Uint32 STACK_DEPTH = 12;		// frames captured per sample
+	static constexpr Uint32 TOP_CALLSITES = 5;		// callsites printed per report
+
+	struct FrameCounts {
+		Uint64 allocations = 0;
+		Uint64 frees = 0;
+		Uint64 bytes = 0;
+	};
+
+public:
+	//Pure static class
+	AllocationAudit() = delete;
+	AllocationAudit(AllocationAudit const&) = delete;
+	AllocationAudit(AllocationAudit&&) = delete;
+	AllocationAudit& operator=(AllocationAudit const&) = delete;
+	AllocationAudit& operator=(AllocationAudit&&) = delete;
+	~AllocationAudit() = delete;
+
+	static void SetMode(Mode mode) noexcept;
+	static Mode GetMode() noexcept;
+
+	// Frames to ignore from now on, e.g. after loading a level
+	static void Rearm(Uint32 warmup_frames = 120) noexcept;
+
+	// Per-frame counts of these resources are included in reports, to tell
+	// which allocations came through pmr containers
+	static void Watch(DebugMemoryResource* resource);
+	static void Unwatch(DebugMemoryResource* resource);
+
+	// Called by the hooks
+	static void RecordAllocation(SizeT bytes) noexcept;
+	static void RecordFree() noexcept;
+
+	// Closes the current frame's counts and reports it if needed
+	static void FrameEnd();
+
+	static FrameCounts LastFrame() noexcept;
+	static Bool IsEnabled() noexcept;	// false if built without ALLOC_AUDIT
+};
@@ -35,7 +35,7 @@ void Animation::LoadAnimation(String const anim_name_, Model* model) {
 	ReadMissingBones(p_anim, *model);
 }
 
-Bone* Animation::FindBone(String const name) {
+Bone* Animation::FindBone(String const& name) {
 	auto it = std::find_if(bones.begin(), bones.end(),
 		[&](Bone const& bone) {
 			return bone.GetBoneName() == name;
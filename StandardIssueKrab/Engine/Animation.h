@@ -31,7 +31,7 @@ public:
 
 	void LoadAnimation(String const anim_name, Model* model);
 
-	Bone* FindBone(String const name);
+	Bone* FindBone(String const& name);
 
 	Float32 GetTicksPerSecond() const;
 	Float32 GetDuration() const;
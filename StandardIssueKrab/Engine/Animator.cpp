@@ -36,7 +36,7 @@ void Animator::NewAnimation(Animation* p_anim) {
 }
 
 void Animator::CalculateBoneTransform(AssimpNodeData const* node, Mat4 parent_transform) {
-	String node_name = node->name;
+	String const& node_name = node->name;
 	Mat4 node_transform = node->transform;
 
 	Bone* bone = curr_anim->FindBone(node_name);
@@ -1,5 +1,5 @@
 SetAggro(false)
 
-if (radius_sq > dist_sq) then
+if (in_range) then
 	SetAggro(true)
 end
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "Collision.h"
 
+#include <atomic>
+
 namespace Collision {
 
 	// Bounding volume
@@ -134,6 +136,17 @@ namespace Collision {
 		NodePool tree = {};
 		Int32    rootIdx = NullIdx;
 
+		// Stats: number of nodes touched by Query calls since the last reset.
+		// Atomic since queries may run concurrently (see QueryBatch).
+		mutable std::atomic<Uint32> nodesVisited = 0;
+
+		// Counts nodes visited by one query, and adds them to nodesVisited once it ends
+		struct VisitCounter {
+			std::atomic<Uint32>& total;
+			Uint32 count = 0;
+			~VisitCounter() { total.fetch_add(count, std::memory_order_relaxed); }
+		};
+
 	public:
 		static constexpr Int32 NullIdx = -1;
 
@@ -148,6 +161,9 @@ namespace Collision {
 		void		   Query(Float32 radius, Vec3 const& center, BVHIntersectionQuery auto&& queryCallback) const;
 		void		   Query(Ray const& ray, BVHRayCastQuery auto&& queryCallback) const;
 
+		Uint32		   NodesVisited() const { return nodesVisited.load(std::memory_order_relaxed); }
+		void		   ResetNodesVisited() const { nodesVisited.store(0, std::memory_order_relaxed); }
+
 		// DEBUG ONLY
 		void ForEach(std::invocable<BV const&> auto fn);
 
@@ -29,6 +29,8 @@ namespace Collision
 		stack.reserve(256);
 		stack.push_back(rootIdx);
 
+		VisitCounter visited{ nodesVisited };
+
 		Int32 currIdx = NullIdx;
 		while (stack.size() > 0)
 		{
@@ -38,6 +40,7 @@ namespace Collision
 			if (currIdx == NullIdx) { continue; }
 
 			BVHNode const& curr = tree[currIdx];
+			++visited.count;
 
 			if (curr.bv.fatBounds.Intersects(box))
 			{
@@ -62,6 +65,8 @@ namespace Collision
 		stack.reserve(256);
 		stack.push_back(rootIdx);
 
+		VisitCounter visited{ nodesVisited };
+
 		Int32 currIdx = NullIdx;
 		while (stack.size() > 0)
 		{
@@ -71,6 +76,7 @@ namespace Collision
 			if (currIdx == NullIdx) { continue; }
 
 			BVHNode const& curr = tree[currIdx];
+			++visited.count;
 
 			if (curr.bv.fatBounds.DistSquaredFromPoint(c) < r2)
 			{
@@ -93,6 +99,8 @@ namespace Collision
 		stack.reserve(256);
 		stack.push_back(rootIdx);
 
+		VisitCounter visited{ nodesVisited };
+
 		Int32 currIdx = NullIdx;
 		while (stack.size() > 0)
 		{
@@ -102,6 +110,7 @@ namespace Collision
 			if (currIdx == NullIdx) { continue; }
 
 			BVHNode const& curr = tree[currIdx];
+			++visited.count;
 
 			if (Ray::CastResult const r = ray.Cast(curr.bv.fatBounds); r.hit)
 			{
@@ -103,6 +103,6 @@ Uint32 Bone::GetBoneID() const {
 	return id;
 }
 
-String Bone::GetBoneName() const {
+String const& Bone::GetBoneName() const {
 	return name;
 }
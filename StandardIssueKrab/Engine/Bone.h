@@ -8,7 +8,7 @@ public:
 
 	Mat4 GetLocalTransform() const;
 	Uint32 GetBoneID() const;
-	String GetBoneName() const;
+	String const& GetBoneName() const;
 
 private:
 	Uint32 num_key_frames;
@@ -0,0 +1,394 @@
+#pragma once
+
+/*
+A growable FixedObjectPool. Elements live in fixed-size chunks (each one a
+FixedObjectPool<T, ChunkSize>) which are allocated on demand from a memory
+resource. Like FixedObjectPool this:
+-- has O(1) insert/emplace (plus a new chunk allocation when every chunk is full)
+-- guarantees pointers/references to elements remain valid until erase is called
+	on that element
+-- iterates elements as contiguously as possible using each chunk's skipfield,
+	and skips over empty chunks
+
+Unlike FixedObjectPool:
+-- memory use follows the number of live elements instead of a compile-time maximum
+-- erase is O(log(number of chunks)) since it has to find the chunk owning the
+	element, using an index of the chunks sorted by address
+-- inserts go to the first chunk with a free slot, which keeps elements packed
+	toward the oldest chunks
+-- erase never releases a chunk, since a range may still be iterating over it.
+	trim() releases empty chunks (keeping one spare so a pool hovering around a
+	chunk boundary does not reallocate), and the owner calls it at a point where
+	nothing iterates the pool, e.g. right after its cleanup pass. shrink_to_fit()
+	releases every empty chunk.
+-- inserting while a range is iterating is safe even if it allocates a chunk.
+	New chunks are appended, so the range may or may not visit the new element.
+-- compact() moves elements from the last chunks into holes in the first ones,
+	for types whose users hold handles rather than pointers (see Handle.h)
+
+Iteration uses a range, the same as FixedObjectPool:
+
+	ChunkedObjectPool<T, 256> pool;
+	// ... insert elements ...
+
+	for(auto range = pool.all(); not range.is_empty(); range.pop_front()) {
+		T& element = range.front();
+		// ... read/write elements ...
+	}
+*/
+
+#include "FixedObjectPool.h"
+
+#include <memory_resource>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <concepts>
+
+template<class T, std::size_t ChunkSize = 256>
+class ChunkedObjectPool
+{
+public:
+	using value_type = T;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	using chunk_type = FixedObjectPool<T, ChunkSize>;
+	using allocator_type = std::pmr::polymorphic_allocator<>;
+
+	// Range-style iteration support
+	template<bool is_const> class cop_range;
+	using range = cop_range<false>;
+	using const_range = cop_range<true>;
+
+private:
+	using chunk_list = std::pmr::vector<chunk_type*>;
+
+	chunk_list chunks;							// Chunks in allocation order
+	std::pmr::vector<size_type> by_address;		// Indices into chunks, sorted by chunk address
+	allocator_type alloc;						// Used to allocate chunks
+	size_type total_size = 0;					// Number of active elements across all chunks
+	size_type first_open_chunk = 0;				// Index of the first chunk with a free slot. Value == chunks.size()  ==>  every chunk is full.
+	size_type empty_chunks = 0;					// Number of allocated chunks with no active elements
+
+public:
+	ChunkedObjectPool() noexcept = default;
+
+	explicit ChunkedObjectPool(allocator_type const& alloc_) noexcept
+		: chunks{ alloc_ }, by_address{ alloc_ }, alloc{ alloc_ }
+	{}
+
+	ChunkedObjectPool(const ChunkedObjectPool&) = delete;
+	ChunkedObjectPool(ChunkedObjectPool&&) = delete;
+	ChunkedObjectPool& operator=(const ChunkedObjectPool&) = delete;
+	ChunkedObjectPool& operator=(ChunkedObjectPool&&) = delete;
+
+	~ChunkedObjectPool() noexcept {
+		release_all_chunks();
+	}
+
+	[[nodiscard]]
+	pointer insert(const_reference val) {
+		return emplace(val);
+	}
+
+	[[nodiscard]]
+	pointer insert(value_type&& val = value_type{}) {
+		return emplace(std::move(val));
+	}
+
+	template<class ... Args>
+	[[nodiscard]]
+	pointer emplace(Args&& ... args) {
+		if (first_open_chunk == chunks.size()) {
+			add_chunk();
+		}
+
+		chunk_type* chunk = chunks[first_open_chunk];
+		if (chunk->size() == 0) {
+			--empty_chunks;
+		}
+
+		pointer result = chunk->emplace(std::forward<Args>(args)...);
+		++total_size;
+
+		// Keep first_open_chunk pointing at a chunk with room (or at the end)
+		while (first_open_chunk < chunks.size() && chunks[first_open_chunk]->full()) {
+			++first_open_chunk;
+		}
+
+		return result;
+	}
+
+	// Returns ptr to next valid element, or nullptr if at end
+	pointer erase(pointer p_val) {
+		assert(p_val != nullptr);
+
+		size_type const idx = chunk_index_of(p_val);
+		assert(idx < chunks.size() && "Element does not belong to this pool");
+
+		pointer next = chunks[idx]->erase(p_val);
+		--total_size;
+		first_open_chunk = std::min(first_open_chunk, idx);
+		if (chunks[idx]->size() == 0) {
+			++empty_chunks;
+		}
+
+		// Next element might be at the start of a later chunk
+		for (size_type i = idx + 1; next == nullptr && i < chunks.size(); ++i) {
+			if (chunks[i]->size() > 0) {
+				next = std::addressof(chunks[i]->all().front());
+			}
+		}
+
+		return next;
+	}
+
+	// Destroys all elements and releases all chunks
+	void clear() {
+		release_all_chunks();
+		chunks.clear();
+		by_address.clear();
+		total_size = 0;
+		first_open_chunk = 0;
+		empty_chunks = 0;
+	}
+
+	// Releases empty chunks but one. Cheap when there is nothing to release.
+	// Invalidates ranges, so never call it while iterating.
+	void trim() {
+		if (empty_chunks > 1) {
+			release_empty_chunks(1);
+		}
+	}
+
+	// Releases every chunk which has no active elements.
+	// Invalidates ranges, so never call it while iterating.
+	void shrink_to_fit() {
+		if (empty_chunks > 0) {
+			release_empty_chunks(0);
+		}
+	}
+
+	// Moves elements out of the last chunks into free slots of the first ones,
+	// so iteration is dense again after heavy churn, then releases the emptied
+	// chunks. Calls on_move(from, to) after move constructing each element at
+	// to and before destroying it at from, so the owner can repoint handles and
+	// back-pointers. Returns the number of elements moved.
+	// Invalidates ranges and pointers to moved elements, so only use it for
+	// types which are referred to by handle, at a point where nothing iterates.
+	template<std::invocable<pointer, pointer> OnMove>
+	size_type compact(OnMove&& on_move) {
+		size_type moved = 0;
+		size_type source = chunks.size();
+
+		while (true) {
+			while (source > 0 && chunks[source - 1]->size() == 0) {
+				--source;
+			}
+			// Stop once there is no free slot in front of the last chunk with elements
+			if (source == 0 || first_open_chunk >= source - 1) {
+				break;
+			}
+
+			chunk_type* from_chunk = chunks[source - 1];
+			chunk_type* to_chunk = chunks[first_open_chunk];
+			if (to_chunk->size() == 0) {
+				--empty_chunks;
+			}
+
+			pointer const from = std::addressof(from_chunk->all().front());
+			pointer const to = to_chunk->emplace(std::move(*from));
+			on_move(from, to);
+			from_chunk->erase(from);
+			++moved;
+
+			if (from_chunk->size() == 0) {
+				++empty_chunks;
+			}
+			while (first_open_chunk < chunks.size() && chunks[first_open_chunk]->full()) {
+				++first_open_chunk;
+			}
+		}
+
+		shrink_to_fit();
+		return moved;
+	}
+
+	range all() {
+		return range{ &chunks, total_size };
+	}
+
+	const_range all() const {
+		return const_range{ &chunks, total_size };
+	}
+
+	size_type size() const noexcept		   { return total_size; }
+
+	bool empty() const noexcept			   { return total_size == 0; }
+
+	size_type capacity() const noexcept	   { return chunks.size() * ChunkSize; }
+
+	size_type chunk_count() const noexcept { return chunks.size(); }
+
+	size_type empty_chunk_count() const noexcept { return empty_chunks; }
+
+	// True if p_val points into one of this pool's chunks. O(log(number of chunks)).
+	bool contains(const_pointer p_val) const noexcept { return chunk_index_of(p_val) < chunks.size(); }
+
+	static constexpr size_type chunk_size() noexcept { return ChunkSize; }
+
+private:
+	void release_all_chunks() noexcept {
+		for (chunk_type* chunk : chunks) {
+			alloc.delete_object(chunk);
+		}
+	}
+
+	void add_chunk() {
+		chunks.push_back(alloc.new_object<chunk_type>());
+		++empty_chunks;
+
+		size_type const idx = chunks.size() - 1;
+		auto const pos = std::upper_bound(by_address.begin(), by_address.end(), idx,
+			[this](size_type l, size_type r) { return std::less<>{}(chunks[l], chunks[r]); });
+		by_address.insert(pos, idx);
+	}
+
+	// Releases empty chunks, keeping the first keep_count of them in allocation order
+	void release_empty_chunks(size_type keep_count) {
+		std::erase_if(chunks, [this, &keep_count](chunk_type* chunk) {
+			if (chunk->size() > 0) { return false; }
+			if (keep_count > 0) {
+				--keep_count;
+				return false;
+			}
+			alloc.delete_object(chunk);
+			--empty_chunks;
+			return true;
+		});
+
+		by_address.resize(chunks.size());
+		std::iota(by_address.begin(), by_address.end(), size_type{ 0 });
+		std::sort(by_address.begin(), by_address.end(),
+			[this](size_type l, size_type r) { return std::less<>{}(chunks[l], chunks[r]); });
+
+		first_open_chunk = 0;
+		while (first_open_chunk < chunks.size() && chunks[first_open_chunk]->full()) {
+			++first_open_chunk;
+		}
+	}
+
+	// The owner is the chunk with the highest address not above p_val
+	size_type chunk_index_of(const_pointer p_val) const noexcept {
+		auto const it = std::upper_bound(by_address.begin(), by_address.end(), p_val,
+			[this](const_pointer p, size_type i) { return std::less<const void*>{}(p, chunks[i]); });
+
+		if (it == by_address.begin() || not chunks[*std::prev(it)]->contains(p_val)) {
+			return chunks.size();
+		}
+		return *std::prev(it);
+	}
+
+
+	// Range Definition
+public:
+
+	template<bool is_const>
+	class cop_range
+	{
+	public:
+		friend class ChunkedObjectPool;
+		template<bool> friend class cop_range;
+
+		using reference = typename std::conditional_t<is_const, typename ChunkedObjectPool::const_reference, typename ChunkedObjectPool::reference>;
+		using chunk_pointer = typename std::conditional_t<is_const, const chunk_type*, chunk_type*>;
+		using chunk_range = typename chunk_type::template fop_range<is_const>;
+
+	private:
+		// Indexed rather than pointing into the chunk list, which may reallocate
+		// when an insert during iteration adds a chunk
+		chunk_list const* chunk_src = nullptr;	// Chunks of the pool being iterated
+		size_type chunk_idx = 0;				// Chunk currently being iterated
+		chunk_range inner = {};					// Remaining elements of the current chunk
+		size_type length = 0;					// Remaining elements across all chunks
+
+	public:
+		// CTORS + DTOR
+		cop_range() noexcept =									default;
+		cop_range(const cop_range& src) noexcept =				default;
+		cop_range(cop_range&&) noexcept =						default;
+		cop_range& operator= (const cop_range& rhs) noexcept =	default;
+		cop_range& operator= (cop_range&& rhs) noexcept =		default;
+		~cop_range() noexcept =									default;
+
+			// Converting from range to const_range
+		template<bool is_const_r = is_const, class = std::enable_if_t<is_const_r>>
+		cop_range(const cop_range<false>& src) noexcept
+			: chunk_src{ src.chunk_src }, chunk_idx{ src.chunk_idx }, inner{ src.inner }, length{ src.length }
+		{ }
+
+		template<bool is_const_r = is_const, class = std::enable_if_t<is_const_r>>
+		cop_range& operator= (const cop_range<false>& rhs) noexcept {
+			chunk_src = rhs.chunk_src;
+			chunk_idx = rhs.chunk_idx;
+			inner = rhs.inner;
+			length = rhs.length;
+			return *this;
+		}
+
+
+		// METHODS
+		bool is_empty() const noexcept {
+			return length == 0;
+		}
+
+		reference front() {
+			assert(!is_empty());
+			return inner.front();
+		}
+
+		void pop_front() {
+			assert(!is_empty());
+
+			inner.pop_front();
+			--length;
+
+			// Move on to the next chunk with elements
+			if (inner.is_empty() && length > 0) {
+				++chunk_idx;
+				seek_nonempty_chunk();
+			}
+		}
+
+	private:
+		// Needed by ChunkedObjectPool::all()
+		explicit cop_range(chunk_list const* chunks_, size_type len)
+			: chunk_src{ chunks_ },
+			length{ len }
+		{
+			if (length > 0) {
+				seek_nonempty_chunk();
+			}
+		}
+
+		// Ends the range early if elements ahead of it were erased during iteration
+		void seek_nonempty_chunk() {
+			chunk_list const& list = *chunk_src;
+			while (chunk_idx < list.size() && list[chunk_idx]->size() == 0) {
+				++chunk_idx;
+			}
+			if (chunk_idx == list.size()) {
+				length = 0;
+				return;
+			}
+			inner = static_cast<chunk_pointer>(list[chunk_idx])->all();
+		}
+	};
+};
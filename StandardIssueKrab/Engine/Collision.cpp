@@ -588,6 +588,34 @@ namespace Collision {
 		return result;
 	}
 
+	ContactManifold AABB::CollideSpeculative(AABB const& other) const {
+		Vec3 const d = other.position - position;
+
+		// Separation on each axis (> 0 means a gap on that axis)
+		Vec3 const sep = glm::abs(d) - (halfwidths + other.halfwidths);
+
+		// The axis of greatest separation is the best separating axis
+		Int32 axis = 0;
+		if (sep.y > sep[axis]) { axis = 1; }
+		if (sep.z > sep[axis]) { axis = 2; }
+
+		Float32 const sign = d[axis] < 0.0f ? -1.0f : 1.0f;
+		Vec3 normal(0);
+		normal[axis] = sign;
+
+		// Put the contact in the middle of the gap, centered on the region 
+		// where the boxes overlap on the other two axes
+		Vec3 contact = 0.5f * (glm::max(Min(), other.Min()) + glm::min(Max(), other.Max()));
+		contact[axis] = position[axis] + sign * (halfwidths[axis] + 0.5f * sep[axis]);
+
+		ContactManifold result{ .normal = normal };
+		result.contacts[result.num_contacts++] = {
+			.position = contact,
+			.penetration = -sep[axis]
+		};
+		return result;
+	}
+
 	// Specialized SAT for OBB: See Ericson 4.4.1-2
 	ContactManifold AABB::CollideAsOBB(Quat const& oA, AABB const& B, Quat const& oB) const
 	{
@@ -907,6 +935,24 @@ namespace Collision {
 		UpdateWorldTransform();
 	}
 
+	AABB Collider::GetBoundingBox() const {
+		switch (type) {
+		break; case Type::Sphere: {
+			return static_cast<Sphere const*>(this)->GetBoundingBox();
+		}
+		break; case Type::Capsule: {
+			return static_cast<Capsule const*>(this)->GetBoundingBox();
+		}
+		break; case Type::Hull: {
+			return static_cast<Hull const*>(this)->GetBoundingBox();
+		}
+		break; default: {
+			SIK_ASSERT(false, "Invalid Collider type.");
+		}
+		}
+		return AABB{ .position = GetWorldPosition(), .halfwidths = Vec3(0) };
+	}
+
 	// Sphere methods
 
 	Sphere::Sphere(Float32 r)
@@ -62,6 +62,10 @@ namespace Collision {
 
 		ContactManifold CollideAsOBB(Quat const& orientation, AABB const& other, Quat const& other_orientation) const;
 
+		// Single contact along the axis of greatest separation. Penetration is 
+		// negative (i.e. it is the gap) when the boxes do not overlap.
+		ContactManifold CollideSpeculative(AABB const& other) const;
+
 		inline Float32 DistSquaredFromPoint(Vec3 const& pt) const;
 
 		// Accessors
@@ -114,6 +118,9 @@ namespace Collision {
 		inline CastResult Cast(AABB const& aabb) const;
 	};
 
+	// Colliders have no vtable. Methods which depend on the shape dispatch on
+	// type, and each RigidBody's colliders are packed together in one block
+	// (see PhysicsManager::ColliderStorage).
 	class Collider {
 	public:
 		friend class PhysicsManager;
@@ -137,9 +144,9 @@ namespace Collision {
 		
 	public:
 		Collider(Type t);
-		virtual ~Collider() noexcept = default;
+		~Collider() noexcept = default;
 
-		virtual AABB GetBoundingBox() const = 0;
+		AABB GetBoundingBox() const;
 
 		void SetOwner(RigidBody const* owner);
 		void UpdateWorldTransform();
@@ -189,7 +196,7 @@ namespace Collision {
 		inline Float32 GetRadius() const;
 		inline void SetRadius(Float32 r);
 
-		AABB GetBoundingBox() const override;
+		AABB GetBoundingBox() const;
 
 	private:
 		inline void ComputeInertiaTensor();
@@ -212,7 +219,7 @@ namespace Collision {
 		inline void SetLength(Float32 length);
 		inline void SetRadius(Float32 radius);
 
-		AABB GetBoundingBox() const override;
+		AABB GetBoundingBox() const;
 
 	private:
 		void ComputeInertiaTensor();
@@ -246,7 +253,7 @@ namespace Collision {
 		Hull();
 		~Hull() noexcept = default;
 
-		AABB			GetBoundingBox() const override;
+		AABB			GetBoundingBox() const;
 
 		// Must be called after modifying vertices field
 		void			ComputeInertiaTensor();
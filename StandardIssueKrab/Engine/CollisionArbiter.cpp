@@ -27,24 +27,48 @@ inline static Vec3 SafeNormalize(Vec3 const& v) {
 	return glm::normalize(v);
 }
 
+// Bodies which are not stepped this update (static, or skipped by their
+// simulation LOD) take part in contacts as if they had infinite mass
+inline static MotionProperties* SolverMotionProperties(RigidBody const* rb, MotionProperties& immovable) {
+	if (not rb->motion_props) {
+		return &immovable;
+	}
+	if (rb->IsSteppedThisUpdate()) {
+		return rb->motion_props;
+	}
+	immovable.linear_velocity = rb->motion_props->linear_velocity;
+	immovable.angular_velocity = rb->motion_props->angular_velocity;
+	return &immovable;
+}
+
 CollisionArbiter::CollisionArbiter(ColliderPair const& pair_)
+	: CollisionArbiter(pair_, Collide(pair_))
+{}
+
+CollisionArbiter::CollisionArbiter(ColliderPair const& pair_, Collision::ContactManifold const& manifold_)
 	: pair{pair_}, 
-	manifold{},
-	friction{ 0 }, restitution{ 0 }
+	manifold{ manifold_ },
+	friction{ 0 }, restitution{ 0 },
+	anchor_a{ pair_.a->position }, anchor_b{ pair_.b->position }
 {
 	friction = glm::sqrt(pair.a->friction * pair.b->friction);
 	restitution = glm::min(pair.a->restitution, pair.b->restitution);
+}
 
-	if (pair.a->IsBoundingBoxUsedAsCollider() || pair.b->IsBoundingBoxUsedAsCollider()) {
+Collision::ContactManifold CollisionArbiter::Collide(ColliderPair const& pair) {
+	if (not UsesColliders(pair)) {
 		Collision::AABB const obbA{ .position = pair.a->position, .halfwidths = pair.a->local_bounds.halfwidths };
 		Collision::AABB const obbB{ .position = pair.b->position, .halfwidths = pair.b->local_bounds.halfwidths };
-		manifold = obbA.CollideAsOBB(pair.a->orientation, obbB, pair.b->orientation);
-		//manifold = pair.a->bounds.Collide(pair.b->bounds); //Collide axis-aligned boxes
-	}
-	else {
-		SIK_ASSERT(pair.idx_a < RigidBody::MAX_COLLIDERS && pair.idx_b < RigidBody::MAX_COLLIDERS, "Indices out of range.");
-		manifold = pair.a->colliders[pair.idx_a]->Collide(pair.b->colliders[pair.idx_b]);
+		return obbA.CollideAsOBB(pair.a->orientation, obbB, pair.b->orientation);
+		//return pair.a->bounds.Collide(pair.b->bounds); //Collide axis-aligned boxes
 	}
+
+	SIK_ASSERT(pair.idx_a < RigidBody::MAX_COLLIDERS && pair.idx_b < RigidBody::MAX_COLLIDERS, "Indices out of range.");
+	return pair.a->colliders[pair.idx_a]->Collide(pair.b->colliders[pair.idx_b]);
+}
+
+Bool CollisionArbiter::UsesColliders(ColliderPair const& pair) {
+	return not pair.a->IsBoundingBoxUsedAsCollider() && not pair.b->IsBoundingBoxUsedAsCollider();
 }
 
 void CollisionArbiter::Update(Collision::ContactManifold const& new_manifold) {
@@ -85,6 +109,42 @@ void CollisionArbiter::Update(Collision::ContactManifold const& new_manifold) {
 
 	manifold.num_contacts = new_manifold.num_contacts;
 	manifold.normal = new_manifold.normal;
+
+	anchor_a = pair.a->position;
+	anchor_b = pair.b->position;
+}
+
+void CollisionArbiter::Speculate(Float32 time_step) {
+	RigidBody const* a = pair.a;
+	RigidBody const* b = pair.b;
+
+	if (manifold.num_contacts > 0) { return; }
+	if (not a->IsFast() && not b->IsFast()) { return; }
+	if (a->IsTrigger() || b->IsTrigger()) { return; }
+
+	Collision::ContactManifold const spec = a->bounds.CollideSpeculative(b->bounds);
+	Float32 const gap = -spec.contacts[0].penetration;
+
+	// Bounds overlap but the narrow phase found no contact, so there is no gap to guard
+	if (gap <= 0.0f) { return; }
+
+	Vec3 const va = a->motion_props ? a->motion_props->linear_velocity : Vec3(0);
+	Vec3 const vb = b->motion_props ? b->motion_props->linear_velocity : Vec3(0);
+	Float32 const closing_speed = glm::dot(va - vb, spec.normal);
+
+	// Cannot reach each other this step
+	if (closing_speed * time_step < gap) { return; }
+
+	manifold = spec;
+}
+
+Bool CollisionArbiter::IsTouching() const {
+	for (Uint32 i = 0; i < manifold.num_contacts; ++i) {
+		if (manifold.contacts[i].penetration >= 0.0f) { 
+			return true; 
+		}
+	}
+	return false;
 }
 
 void CollisionArbiter::PreStep(Float32 time_step) {
@@ -108,12 +168,16 @@ void CollisionArbiter::PreStep(Float32 time_step) {
 	RigidBody* b = pair.b;
 	if (not a || not b || a->IsTrigger() || b->IsTrigger()) { return; }
 	if (not a->IsEnabled() || not b->IsEnabled()) { return; }
+	if (not a->IsSteppedThisUpdate() && not b->IsSteppedThisUpdate()) { return; }
 
-	MotionProperties* a_mp = (a->motion_props) ? a->motion_props : &temp0;
-	MotionProperties* b_mp = (b->motion_props) ? b->motion_props : &temp1;
+	MotionProperties* a_mp = SolverMotionProperties(a, temp0);
+	MotionProperties* b_mp = SolverMotionProperties(b, temp1);
 
 	Vec3 const& normal = manifold.normal;
 
+	// Only pairs with a fast body can have speculative contacts
+	Bool const fast_pair = a->IsFast() || b->IsFast();
+
 	for (Uint32 i = 0; i < manifold.num_contacts; ++i) {
 		Contact& c = manifold.contacts[i];
 
@@ -127,6 +191,26 @@ void CollisionArbiter::PreStep(Float32 time_step) {
 		k_n += glm::dot(normal, a_mp->inv_inertia * glm::cross(ra_X_n, c.ra) + b_mp->inv_inertia * glm::cross(rb_X_n, c.rb));
 		c.mass_n = k_n > 0.0f ? 1.0f / k_n : 0.0f;
 
+		// Compute bias for a fast pair. Speculative contacts (negative penetration)
+		// are apart, so only the approach velocity that would close the remaining
+		// gap this substep is removed. The gap shrinks by the bodies' relative
+		// motion along the normal since the manifold was generated. Done before
+		// the resting check below, since a speculative contact always needs it.
+		if (fast_pair) {
+			Float32 penetration = c.penetration;
+			if (penetration < 0.0f) {
+				Vec3 const rel_disp = (b->position - anchor_b) - (a->position - anchor_a);
+				penetration -= glm::dot(rel_disp, normal);
+			}
+
+			if (penetration < 0.0f) {
+				c.bias = penetration * inv_dt;
+			}
+			else {
+				c.bias = -bias_factor * inv_dt * glm::min(0.0f, -penetration + allowed_penetration);
+			}
+		}
+
 		//// Compute tangent mass
 		Vec3 rel_vel = b_mp->linear_velocity + glm::cross(b_mp->angular_velocity, c.rb) - (a_mp->linear_velocity + glm::cross(a_mp->angular_velocity, c.ra));
 		if (glm::epsilonEqual(glm::length2(rel_vel), 0.0f, 0.001f)) { continue; }
@@ -139,8 +223,11 @@ void CollisionArbiter::PreStep(Float32 time_step) {
 		k_t += glm::dot(tangent, a_mp->inv_inertia * glm::cross(ra_X_t, c.ra) + b_mp->inv_inertia * glm::cross(rb_X_t, c.rb));
 		c.mass_t = k_t != 0.0f ? 1.0f / k_t : 0.0f;
 
-		// Compute bias
-		c.bias = -bias_factor * inv_dt * glm::min(0.0f, -c.penetration + allowed_penetration);
+		// Compute bias. Resting contacts of other pairs skip it, as they did
+		// before speculative contacts were added.
+		if (not fast_pair) {
+			c.bias = -bias_factor * inv_dt * glm::min(0.0f, -c.penetration + allowed_penetration);
+		}
 
 		// Integrate velocities as we accumulate impulses
 		Vec3 p = c.impulse_n * normal /* + c.impulse_t * tangent*/;
@@ -172,9 +259,10 @@ void CollisionArbiter::ApplyImpulse() {
 	RigidBody* b = pair.b;
 	if (not a || not b || a->IsTrigger() || b->IsTrigger()) { return; }
 	if (not a->IsEnabled() || not b->IsEnabled()) { return; }
+	if (not a->IsSteppedThisUpdate() && not b->IsSteppedThisUpdate()) { return; }
 
-	MotionProperties* a_mp = (a->motion_props) ? a->motion_props : &temp0;
-	MotionProperties* b_mp = (b->motion_props) ? b->motion_props : &temp1;
+	MotionProperties* a_mp = SolverMotionProperties(a, temp0);
+	MotionProperties* b_mp = SolverMotionProperties(b, temp1);
 
 	Vec3 const& normal = manifold.normal;
 
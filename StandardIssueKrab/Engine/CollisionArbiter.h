@@ -11,9 +11,33 @@ struct CollisionArbiter
 
 	Float32 friction, restitution;
 
+	// Body positions when the manifold was generated. Used to estimate how much
+	// of the gap in a speculative contact has been closed during substeps.
+	Vec3 anchor_a, anchor_b;
+
 	// Methods
 	explicit CollisionArbiter(ColliderPair const& pair);
+
+	// Uses a manifold which was already computed for this pair (e.g. by a ContactBatch)
+	CollisionArbiter(ColliderPair const& pair, Collision::ContactManifold const& manifold);
+
+	// Narrow phase for the pair. Bodies using their bounding box as collider
+	// collide as OBBs, otherwise the pair's colliders are used.
+	static Collision::ContactManifold Collide(ColliderPair const& pair);
+
+	// True if Collide uses the pair's colliders, so it can be batched instead
+	static Bool UsesColliders(ColliderPair const& pair);
+
 	void Update(Collision::ContactManifold const& new_manifold);
+
+	// If either body is fast and the narrow phase found no contacts, adds a 
+	// speculative contact (negative penetration) when the bodies are closing 
+	// fast enough to meet within time_step.
+	void Speculate(Float32 time_step);
+
+	// True if at least one contact is an actual overlap, i.e. not speculative
+	Bool IsTouching() const;
+
 	void PreStep(Float32 time_step);
 	void ApplyImpulse();
 };
\ No newline at end of file
@@ -48,8 +48,49 @@ public:
 	};
 	static constexpr SizeT NUM_COMPONENTS{ static_cast<SizeT>(Type::INVALID) };
 
+	// Per-frame callbacks, as bits. See GetPhases.
+	enum Phase : Uint8 {
+		PHASE_NONE			= 0,
+		PHASE_UPDATE		= 1 << 0,
+		PHASE_FIXED_UPDATE	= 1 << 1,
+		PHASE_ON_COLLIDE	= 1 << 2,
+		PHASE_COUNT			= 3
+	};
+
+	// What a type's Update and FixedUpdate touch besides the component itself,
+	// as bits. A type declares it with a static constexpr Uint16 access member,
+	// and types which don't get ACCESS_MAIN_THREAD. See ComponentStorage.
+	enum Access : Uint16 {
+		ACCESS_OWN_DATA					= 0,		// only the component's members
+		ACCESS_READ_TRANSFORM			= 1 << 0,	// the owner's Transform
+		ACCESS_WRITE_TRANSFORM			= 1 << 1,
+		ACCESS_READ_RIGIDBODY			= 1 << 2,	// the owner's RigidBody
+		ACCESS_WRITE_RIGIDBODY			= 1 << 3,
+		ACCESS_READ_OTHER_TRANSFORMS	= 1 << 4,	// any other object's Transform
+		ACCESS_READ_OTHER_RIGIDBODIES	= 1 << 5,
+		ACCESS_READ_GLOBALS				= 1 << 6,	// managers and game state, which only the main thread writes
+		ACCESS_MAIN_THREAD				= 1 << 7,	// anything else, e.g. calls into other objects or writes to globals
+		ACCESS_ALLOCATES				= 1 << 8	// allocates, e.g. containers on the frame or scene resource
+	};
+
+	// Components in the same group update at the same rate, which is set
+	// through the TickScheduler. Default updates every frame.
+	enum class TickGroup : Uint8 {
+		Default = 0,
+		AI,
+		Effects,
+		Ambient,
+
+		Count
+	};
+
 private:
+	friend class TickScheduler;
+
 	GameObject* p_owner_object;
+	TickGroup tick_group = TickGroup::Default;
+	Float32 pending_dt = 0.0f;		 // time since the last Update, while its group skips frames
+	Float32 pending_fixed_dt = 0.0f; // same for FixedUpdate
 
 public:
 	// Ctors defaulted
@@ -82,12 +123,26 @@ public:
 	//Returns the name of the component as StringID. Returns "INVALID"_sid.
 	virtual constexpr StringID GetNameSID() const;
 
+	//Size and alignment of the most derived type, so a component can be
+	//returned to the allocator it came from through a Component*.
+	virtual constexpr SizeT GetSize() const = 0;
+	virtual constexpr SizeT GetAlignment() const = 0;
+
+	//The Phase bits of the callbacks the most derived type overrides. Found at
+	//compile-time by VALID_COMPONENT, so callers can skip the empty base ones.
+	virtual constexpr Uint8 GetPhases() const = 0;
+
 	//Sets a GameObject as the owner of the component instance
 	void SetOwner(GameObject* p_owner_object);
 
 	//Sets a GameObject as the owner of the component instance
 	GameObject* GetOwner();
 
+	//Sets how often Update and FixedUpdate are called. Usually set once in
+	//the constructor of a component type, e.g. SetTickGroup(TickGroup::AI).
+	inline void SetTickGroup(TickGroup group) noexcept { tick_group = group; }
+	inline TickGroup GetTickGroup() const noexcept { return tick_group; }
+
 	/*
 	* Base link function. Does nothing
 	* Links the component with other components that are 
@@ -133,6 +188,36 @@ concept ValidComponent = std::derived_from<T, Component> && requires {
 	std::same_as<std::remove_cvref_t<decltype(T::name)>, const char*>;
 };
 
+// Phase bits of the base callbacks C overrides. Taking the address of an
+// inherited member function gives a pointer to member of Component, while an
+// override gives one to member of C. A private override cannot have its
+// address taken here, so it counts as overridden too.
+template<class C>
+constexpr Uint8 OverriddenPhases() {
+	Uint8 phases = Component::PHASE_NONE;
+	if constexpr (not requires { { &C::Update } -> std::same_as<void (Component::*)(Float32)>; }) {
+		phases |= Component::PHASE_UPDATE;
+	}
+	if constexpr (not requires { { &C::FixedUpdate } -> std::same_as<void (Component::*)(Float32)>; }) {
+		phases |= Component::PHASE_FIXED_UPDATE;
+	}
+	if constexpr (not requires { { &C::OnCollide } -> std::same_as<void (Component::*)(GameObject*)>; }) {
+		phases |= Component::PHASE_ON_COLLIDE;
+	}
+	return phases;
+}
+
+// Access bits C declares, or ACCESS_MAIN_THREAD if it declares none
+template<class C>
+constexpr Uint16 DeclaredAccess() {
+	if constexpr (requires { { C::access } -> std::convertible_to<Uint16>; }) {
+		return C::access;
+	}
+	else {
+		return Component::ACCESS_MAIN_THREAD;
+	}
+}
+
 // Assigns a type to the component. Must use this in the header/declaration for each game-specific component.
 #ifndef VALID_COMPONENT
 #define VALID_COMPONENT(component) \
@@ -141,5 +226,8 @@ constexpr Component::Type GetType() const override { return type; } \
 static constexpr StringID name_sid{ #component##_sid }; \
 constexpr StringID GetNameSID() const override { return name_sid; } \
 static constexpr const char* name{ #component }; \
-constexpr const char* GetName() const override { return name; }
+constexpr const char* GetName() const override { return name; } \
+constexpr SizeT GetSize() const override { return sizeof(component); } \
+constexpr SizeT GetAlignment() const override { return alignof(component); } \
+constexpr Uint8 GetPhases() const override { return OverriddenPhases<component>(); }
 #endif
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include "stdafx.h"
+#include "ComponentStorage.h"
+
+#include <execution>
+
+// Below this many jobs in a batch, updating on one thread is cheaper than
+// handing them out to the parallel algorithm
+static constexpr SizeT PARALLEL_THRESHOLD = 64;
+
+////////////////////////////////////////////////////////////////////////////////
+// Access
+////////////////////////////////////////////////////////////////////////////////
+
+// What a type reads and writes, by resource
+struct AccessSets {
+	Uint8 own_reads;
+	Uint8 own_writes;
+	Uint8 other_reads;
+};
+
+static constexpr Uint8 TRANSFORM_RESOURCE = 1 << 0;
+static constexpr Uint8 RIGIDBODY_RESOURCE = 1 << 1;
+
+static AccessSets ToSets(Uint16 access) {
+	auto resources = [access](Uint16 transform_bit, Uint16 rigidbody_bit) {
+		return static_cast<Uint8>(((access & transform_bit) ? TRANSFORM_RESOURCE : 0)
+			| ((access & rigidbody_bit) ? RIGIDBODY_RESOURCE : 0));
+	};
+
+	AccessSets sets{
+		.own_reads = resources(Component::ACCESS_READ_TRANSFORM, Component::ACCESS_READ_RIGIDBODY),
+		.own_writes = resources(Component::ACCESS_WRITE_TRANSFORM, Component::ACCESS_WRITE_RIGIDBODY),
+		.other_reads = resources(Component::ACCESS_READ_OTHER_TRANSFORMS, Component::ACCESS_READ_OTHER_RIGIDBODIES)
+	};
+	sets.own_reads |= sets.own_writes;
+	return sets;
+}
+
+// True if one object's components of this type may update at the same time
+// as another's. Objects have at most one component of a type, so only reads
+// of other objects can clash with the type's own writes.
+static Bool IsParallelSafe(Uint16 access) {
+	if (access & (Component::ACCESS_MAIN_THREAD | Component::ACCESS_ALLOCATES)) { return false; }
+
+	AccessSets const sets = ToSets(access);
+	return (sets.own_writes & sets.other_reads) == 0;
+}
+
+// True if types with these accesses must not update at the same time
+static Bool Conflicts(Uint16 lhs_access, Uint16 rhs_access) {
+	AccessSets const lhs = ToSets(lhs_access);
+	AccessSets const rhs = ToSets(rhs_access);
+	return (lhs.own_writes & (rhs.own_reads | rhs.other_reads)) != 0
+		|| (rhs.own_writes & (lhs.own_reads | lhs.other_reads)) != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ComponentStorage
+////////////////////////////////////////////////////////////////////////////////
+
+Bool ComponentStorage::Destroy(Component* comp) {
+	ColumnBase* column = columns[static_cast<SizeT>(comp->GetType())].get();
+	return column != nullptr && column->Destroy(comp);
+}
+
+// Jobs are gathered ahead of the types before them, whose updates may have
+// disabled the owner since
+void ComponentStorage::RunJob(Component::Phase phase, Job const& job) {
+	if (not job.comp->GetOwner()->IsActive()) { return; }
+
+	if (phase == Component::PHASE_UPDATE) { job.comp->Update(job.dt); }
+	else { job.comp->FixedUpdate(job.dt); }
+}
+
+void ComponentStorage::Update(Float32 dt, TickScheduler const& scheduler) {
+	Sweep(Component::PHASE_UPDATE, dt, scheduler, false);
+}
+
+void ComponentStorage::FixedUpdate(Float32 fixed_dt, TickScheduler const& scheduler) {
+	Sweep(Component::PHASE_FIXED_UPDATE, fixed_dt, scheduler, false);
+}
+
+void ComponentStorage::Update(Vector<GameObject*> const& objects, Float32 dt, TickScheduler const& scheduler) {
+	GatherObjects(Component::PHASE_UPDATE, objects, dt, scheduler);
+	Sweep(Component::PHASE_UPDATE, dt, scheduler, true);
+}
+
+void ComponentStorage::FixedUpdate(Vector<GameObject*> const& objects, Float32 fixed_dt, TickScheduler const& scheduler) {
+	GatherObjects(Component::PHASE_FIXED_UPDATE, objects, fixed_dt, scheduler);
+	Sweep(Component::PHASE_FIXED_UPDATE, fixed_dt, scheduler, true);
+}
+
+// Sorts the due components of the active objects by type into object_jobs
+void ComponentStorage::GatherObjects(Component::Phase phase, Vector<GameObject*> const& objects, Float32 dt, TickScheduler const& scheduler) {
+	for (GameObject* obj : objects) {
+		if (not obj->IsActive()) { continue; }
+
+		for (UniquePtr<Component> const& comp : obj->GetComponentArray()) {
+			SizeT const type = static_cast<SizeT>(comp->GetType());
+			ColumnBase const* column = columns[type].get();
+			if (column != nullptr && (column->GetPhases() & phase) == 0) { continue; }
+
+			Float32 tick_dt = dt;
+			Bool const due = phase == Component::PHASE_UPDATE
+				? scheduler.ShouldUpdate(*comp, tick_dt)
+				: scheduler.ShouldFixedUpdate(*comp, tick_dt);
+			if (due) {
+				object_jobs[type].push_back(Job{ comp.get(), tick_dt });
+			}
+		}
+	}
+}
+
+// Goes through the types in order, adding each type to the batch until one
+// conflicts with it. Main thread types end the batch and run alone. The jobs
+// come from the columns, or from object_jobs if from_objects is set.
+void ComponentStorage::Sweep(Component::Phase phase, Float32 dt, TickScheduler const& scheduler, Bool from_objects) {
+	Uint16 batch_access = Component::ACCESS_OWN_DATA;
+
+	for (SizeT type = 0; type < Component::NUM_COMPONENTS; ++type) {
+		ColumnBase* column = columns[type].get();
+		Vector<Job>& type_jobs = object_jobs[type];
+		if (from_objects ? type_jobs.empty() : (column == nullptr || (column->GetPhases() & phase) == 0)) { continue; }
+
+		// Components not made by Create have no column to declare their access
+		Uint16 const access = column ? column->GetAccess() : Component::ACCESS_MAIN_THREAD;
+		if (not IsParallelSafe(access)) {
+			RunBatch(phase);
+			batch_access = Component::ACCESS_OWN_DATA;
+
+			if (from_objects) {
+				for (Job const& job : type_jobs) { RunJob(phase, job); }
+				type_jobs.clear();
+			}
+			else if (phase == Component::PHASE_UPDATE) { column->Update(dt, scheduler); }
+			else { column->FixedUpdate(dt, scheduler); }
+			RunDeferred();
+			continue;
+		}
+
+		if (Conflicts(batch_access, access)) {
+			RunBatch(phase);
+			batch_access = Component::ACCESS_OWN_DATA;
+		}
+		if (from_objects) {
+			jobs.insert(jobs.end(), type_jobs.begin(), type_jobs.end());
+			type_jobs.clear();
+		}
+		else { column->Gather(phase, dt, scheduler, jobs); }
+		batch_access |= access;
+	}
+	RunBatch(phase);
+}
+
+void ComponentStorage::RunBatch(Component::Phase phase) {
+	auto run = [phase](Job const& job) {
+		ParallelJobScope const scope{};
+		RunJob(phase, job);
+	};
+
+	if (jobs.size() < PARALLEL_THRESHOLD) {
+		std::for_each(jobs.begin(), jobs.end(), run);
+	}
+	else {
+		std::for_each(std::execution::par, jobs.begin(), jobs.end(), run);
+	}
+	jobs.clear();
+	RunDeferred();
+}
+
+void ComponentStorage::Defer(Command command) {
+	std::scoped_lock lock{ deferred_mtx };
+	deferred.push_back(std::move(command));
+}
+
+void ComponentStorage::RunDeferred() {
+	while (true) {
+		{
+			std::scoped_lock lock{ deferred_mtx };
+			if (deferred.empty()) { return; }
+			running.swap(deferred);
+		}
+
+		for (Command& command : running) {
+			command();
+		}
+		running.clear();
+	}
+}
+
+SizeT ComponentStorage::Count(Component::Type type) const {
+	ColumnBase const* column = columns[static_cast<SizeT>(type)].get();
+	return column ? column->Size() : 0;
+}
+
+void ComponentStorage::Trim() {
+	for (UniquePtr<ColumnBase>& column : columns) {
+		if (column) { column->Trim(); }
+	}
+}
+
+void ComponentStorage::Clear() {
+	for (UniquePtr<ColumnBase>& column : columns) {
+		SIK_ASSERT(column == nullptr || column->Size() == 0, "Cleared component storage while components were alive.");
+		column.reset();
+	}
+
+	std::scoped_lock lock{ deferred_mtx };
+	deferred.clear();
+}
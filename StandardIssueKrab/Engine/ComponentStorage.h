@@ -0,0 +1,233 @@
+#pragma once
+
+#include "ChunkedObjectPool.h"
+#include "GameObject.h"
+#include "MemoryManager.h"
+#include "TickScheduler.h"
+
+/*
+* Stores game-side components by Component::Type. Every type has its own
+* column: a chunked pool holding only components of that type, so a system
+* which runs over every Health or every Debris walks one dense block of memory
+* instead of following each GameObject's component pointers around the heap.
+*
+* GameObjects still keep pointers to their components, so HasComponent and
+* GetComponentArray work as before. The storage owns the memory, and a
+* GameObject gives its components back through Destroy when it dies.
+*
+* A type's column is created the first time one of its components is, since
+* only Create<C> knows the concrete type. Columns allocate their chunks from
+* the scene resource, and Clear destroys them before the scene arena is
+* released. Only Defer is thread-safe.
+*
+* Update and FixedUpdate run types in parallel where their declared
+* Component::Access allows it. Consecutive types which don't conflict form a
+* batch, and every component in a batch is updated on the parallel algorithms'
+* thread pool, one job per component. A type conflicts with another if it
+* writes something of its owner the other reads or writes, or writes what the
+* other reads of other objects. Types which declare no access, or write their
+* owner's Transform or RigidBody while reading other objects', run alone on
+* the main thread between batches, in Component::Type order as before. So do
+* types which declare ACCESS_ALLOCATES: the default, frame and scene memory
+* resources are not thread-safe, and debug builds assert if a parallel
+* component allocates from them (see ParallelJobScope).
+*
+* Parallel components must not call into other objects, create or delete
+* objects, allocate, or write globals. They Defer such calls instead, and the
+* commands run on the main thread, in the order deferred, after their batch.
+*
+* The overloads taking a list of objects sweep only those objects' components,
+* the same way. Game states use them to update the objects they hold.
+*
+* Usage (a system over one type):
+*	p_game_obj_manager->GetComponentStorage().ForEach<Health>([](Health& h) { ... });
+*
+* Usage (declaring access and deferring a call into another object):
+*	static constexpr Uint16 access = ACCESS_READ_TRANSFORM | ACCESS_READ_OTHER_TRANSFORMS;
+*	...
+*	p_game_obj_manager->Defer([this] { magnet->AddDebris(this); });
+*/
+class ComponentStorage
+{
+public:
+	static constexpr SizeT CHUNK_SIZE = 64;
+
+	using Command = std::function<void()>;
+
+private:
+	// A component due to update in the current batch
+	struct Job {
+		Component* comp;
+		Float32	   dt;
+	};
+	// Type-erased view of one type's column
+	class ColumnBase
+	{
+	public:
+		virtual ~ColumnBase() = default;
+
+		// False if comp was not created by this column
+		virtual Bool Destroy(Component* comp) = 0;
+		virtual void Update(Float32 dt, TickScheduler const& scheduler) = 0;
+		virtual void FixedUpdate(Float32 fixed_dt, TickScheduler const& scheduler) = 0;
+
+		// Appends a job for every component due to run phase, without running it
+		virtual void Gather(Component::Phase phase, Float32 dt, TickScheduler const& scheduler, Vector<Job>& jobs) = 0;
+		virtual Uint8 GetPhases() const = 0;
+		virtual Uint16 GetAccess() const = 0;
+		virtual void Trim() = 0;
+		virtual SizeT Size() const = 0;
+	};
+
+	template<ValidComponent C>
+	class Column final : public ColumnBase
+	{
+	public:
+		ChunkedObjectPool<C, CHUNK_SIZE> pool;
+
+		explicit Column(PolymorphicAllocator alloc) : pool{ alloc } {}
+
+		Bool Destroy(Component* comp) override;
+		void Update(Float32 dt, TickScheduler const& scheduler) override;
+		void FixedUpdate(Float32 fixed_dt, TickScheduler const& scheduler) override;
+		void Gather(Component::Phase phase, Float32 dt, TickScheduler const& scheduler, Vector<Job>& jobs) override;
+		Uint8 GetPhases() const override { return OverriddenPhases<C>(); }
+		Uint16 GetAccess() const override { return DeclaredAccess<C>(); }
+		void Trim() override { pool.trim(); }
+		SizeT Size() const override { return pool.size(); }
+	};
+
+	Array<UniquePtr<ColumnBase>, Component::NUM_COMPONENTS> columns;
+	Vector<Job> jobs;				// kept between sweeps for its capacity
+	Array<Vector<Job>, Component::NUM_COMPONENTS> object_jobs; // by type, for sweeps over a list of objects
+
+	// Deferred from any thread, so not on the default resource, which need
+	// not be thread-safe
+	std::mutex		deferred_mtx;	// guards deferred
+	Vector<Command> deferred{ std::pmr::new_delete_resource() };
+	Vector<Command> running{ std::pmr::new_delete_resource() };	// commands being run by RunDeferred
+
+public:
+	// Defaulted ctors and dtor
+
+	// Creates a component of type C in its column, without an owner
+	template<ValidComponent C> C* Create();
+
+	// Destroys a component made by Create. Returns false, leaving comp alone,
+	// if it was allocated some other way.
+	Bool Destroy(Component* comp);
+
+	// Calls Update/FixedUpdate on every component whose owner is active and
+	// whose tick group is due, in parallel batches of types as described above
+	void Update(Float32 dt, TickScheduler const& scheduler);
+	void FixedUpdate(Float32 fixed_dt, TickScheduler const& scheduler);
+
+	// Same, over the components of the active objects in objects only
+	void Update(Vector<GameObject*> const& objects, Float32 dt, TickScheduler const& scheduler);
+	void FixedUpdate(Vector<GameObject*> const& objects, Float32 fixed_dt, TickScheduler const& scheduler);
+
+	// Queues command to run on the main thread after the current batch, or at
+	// the end of the frame if no sweep is running. Safe from any thread.
+	void Defer(Command command);
+
+	// Runs the deferred commands, including any they defer. Main thread only.
+	void RunDeferred();
+
+	// Calls fn(C&) on every component of type C, active or not
+	template<ValidComponent C, class F> void ForEach(F fn);
+
+	// Number of live components of a type
+	SizeT Count(Component::Type type) const;
+
+	// Releases spare chunks of every column. Never call it while iterating.
+	void Trim();
+
+	// Destroys every column, which must all be empty, and drops the deferred
+	// commands
+	void Clear();
+
+private:
+	void GatherObjects(Component::Phase phase, Vector<GameObject*> const& objects, Float32 dt, TickScheduler const& scheduler);
+	void Sweep(Component::Phase phase, Float32 dt, TickScheduler const& scheduler, Bool from_objects);
+	void RunBatch(Component::Phase phase);
+	static void RunJob(Component::Phase phase, Job const& job);
+};
+
+
+// Inline definitions
+template<ValidComponent C>
+C* ComponentStorage::Create() {
+	UniquePtr<ColumnBase>& column = columns[static_cast<SizeT>(C::type)];
+	if (column == nullptr) {
+		column = std::make_unique<Column<C>>(p_memory_manager->GetSceneAllocator());
+	}
+	return static_cast<Column<C>*>(column.get())->pool.emplace();
+}
+
+template<ValidComponent C, class F>
+void ComponentStorage::ForEach(F fn) {
+	ColumnBase* column = columns[static_cast<SizeT>(C::type)].get();
+	if (column == nullptr) { return; }
+
+	auto& pool = static_cast<Column<C>*>(column)->pool;
+	for (auto r = pool.all(); not r.is_empty(); r.pop_front()) {
+		fn(r.front());
+	}
+}
+
+template<ValidComponent C>
+Bool ComponentStorage::Column<C>::Destroy(Component* comp) {
+	C* p_comp = static_cast<C*>(comp);
+	if (not pool.contains(p_comp)) { return false; }
+
+	pool.erase(p_comp);
+	return true;
+}
+
+// Components made while the sweep runs (e.g. an object spawned by an Update)
+// may or may not be visited this frame, the same as for any ChunkedObjectPool.
+// Types which keep the empty base callback are not swept at all.
+template<ValidComponent C>
+void ComponentStorage::Column<C>::Update(Float32 dt, TickScheduler const& scheduler) {
+	if constexpr ((OverriddenPhases<C>() & Component::PHASE_UPDATE) == 0) { return; }
+
+	for (auto r = pool.all(); not r.is_empty(); r.pop_front()) {
+		Component& comp = r.front();
+		GameObject* owner = comp.GetOwner();
+		Float32 tick_dt = dt;
+		if (owner != nullptr && owner->IsActive() && scheduler.ShouldUpdate(comp, tick_dt)) {
+			comp.Update(tick_dt);
+		}
+	}
+}
+
+template<ValidComponent C>
+void ComponentStorage::Column<C>::Gather(Component::Phase phase, Float32 dt, TickScheduler const& scheduler, Vector<Job>& jobs) {
+	for (auto r = pool.all(); not r.is_empty(); r.pop_front()) {
+		Component& comp = r.front();
+		GameObject* owner = comp.GetOwner();
+		if (owner == nullptr || not owner->IsActive()) { continue; }
+
+		Float32 tick_dt = dt;
+		Bool const due = phase == Component::PHASE_UPDATE
+			? scheduler.ShouldUpdate(comp, tick_dt)
+			: scheduler.ShouldFixedUpdate(comp, tick_dt);
+		if (due) {
+			jobs.push_back(Job{ &comp, tick_dt });
+		}
+	}
+}
+
+template<ValidComponent C>
+void ComponentStorage::Column<C>::FixedUpdate(Float32 fixed_dt, TickScheduler const& scheduler) {
+	if constexpr ((OverriddenPhases<C>() & Component::PHASE_FIXED_UPDATE) == 0) { return; }
+
+	for (auto r = pool.all(); not r.is_empty(); r.pop_front()) {
+		Component& comp = r.front();
+		GameObject* owner = comp.GetOwner();
+		Float32 tick_dt = fixed_dt;
+		if (owner != nullptr && owner->IsActive() && scheduler.ShouldFixedUpdate(comp, tick_dt)) {
+			comp.FixedUpdate(tick_dt);
+		}
+	}
+}
@@ -0,0 +1,333 @@
+#include "stdafx.h"
+#include "ContactBatch.h"
+
+#include "SIMD.h"
+
+using namespace SIMD;
+
+namespace Collision {
+
+	namespace detail {
+		////////////////////////////////////////////////////////////////////////
+		// SOA KERNELS
+		////////////////////////////////////////////////////////////////////////
+
+		// One lane per pair. Unused lanes are left zeroed, which the kernels
+		// treat as coincident points and never report contacts for.
+		struct SphereLanes {
+			Float32 pa[3][WIDTH] = {}, ra[WIDTH] = {};
+			Float32 pb[3][WIDTH] = {}, rb[WIDTH] = {};
+		};
+
+		struct SegmentLanes {
+			Float32 a0[3][WIDTH] = {}, a1[3][WIDTH] = {}, ra[WIDTH] = {};
+			Float32 b0[3][WIDTH] = {}, b1[3][WIDTH] = {}, rb[WIDTH] = {};
+		};
+
+		// Normals are valid wherever the centers are not coincident, contacts only where hit
+		struct ContactLanes {
+			Float32 normal[3][WIDTH];
+			Float32 position[3][WIDTH];
+			Float32 penetration[WIDTH];
+			Uint32  hit_mask;
+		};
+
+		static inline void SetLane(Float32 (&dst)[3][WIDTH], Uint32 lane, Vec3 const& v) {
+			dst[0][lane] = v.x;
+			dst[1][lane] = v.y;
+			dst[2][lane] = v.z;
+		}
+
+		static inline Vec3 GetLane(Float32 const (&src)[3][WIDTH], Uint32 lane) {
+			return Vec3(src[0][lane], src[1][lane], src[2][lane]);
+		}
+
+		// Same as Collide(Sphere, Sphere) for 4 pairs of centers and radii
+		static void CollideSpheres(F4 const pa[3], F4 ra, F4 const pb[3], F4 rb, ContactLanes& out) {
+			F4 const d[3] = { Sub(pb[0], pa[0]), Sub(pb[1], pa[1]), Sub(pb[2], pa[2]) };
+			F4 const dist = Sqrt(Dot(d, d));
+			F4 const pen = Sub(Add(ra, rb), dist);
+
+			// Coincident centers have no usable normal
+			F4 const valid = GreaterEqual(dist, Splat(0.0001f));
+			F4 const hit = And(valid, Greater(pen, Zero()));
+
+			F4 const safe_dist = Select(valid, dist, Splat(1.0f));
+			F4 const offset = Sub(ra, Mul(Splat(0.5f), pen));
+			for (Uint32 k = 0; k < 3; ++k) {
+				F4 const n = Div(d[k], safe_dist);
+				Store(out.normal[k], n);
+				Store(out.position[k], Add(Mul(n, offset), pa[k]));
+			}
+			Store(out.penetration, pen);
+			out.hit_mask = MoveMask(hit);
+		}
+
+		// Closest point to p on segment [s0, s1]. Degenerate segments return s0.
+		static void ClosestPointOnSegment(F4 const p[3], F4 const s0[3], F4 const s1[3], F4 out[3]) {
+			F4 const s[3] = { Sub(s1[0], s0[0]), Sub(s1[1], s0[1]), Sub(s1[2], s0[2]) };
+			F4 const r[3] = { Sub(p[0], s0[0]), Sub(p[1], s0[1]), Sub(p[2], s0[2]) };
+			F4 const len2 = Dot(s, s);
+			F4 const degenerate = LessEqual(len2, Splat(0.0001f));
+
+			F4 const t = Select(degenerate, Zero(), Clamp01(Div(Dot(r, s), Select(degenerate, Splat(1.0f), len2))));
+			for (Uint32 k = 0; k < 3; ++k) {
+				out[k] = Add(s0[k], Mul(t, s[k]));
+			}
+		}
+
+		// Branchless version of ClosestPoints(LineSegment, LineSegment), see
+		// Ericson Realtime Collision Detection Ch 5.1.9. Each branch is computed
+		// for every lane and the right one is selected per lane.
+		static void ClosestPointsSegments(F4 const a0[3], F4 const a1[3], F4 const b0[3], F4 const b1[3],
+			F4 c1[3], F4 c2[3]) {
+			F4 const one = Splat(1.0f);
+			F4 const eps = Splat(0.0001f);
+
+			F4 const d1[3] = { Sub(a1[0], a0[0]), Sub(a1[1], a0[1]), Sub(a1[2], a0[2]) };
+			F4 const d2[3] = { Sub(b1[0], b0[0]), Sub(b1[1], b0[1]), Sub(b1[2], b0[2]) };
+			F4 const r[3]  = { Sub(a0[0], b0[0]), Sub(a0[1], b0[1]), Sub(a0[2], b0[2]) };
+
+			F4 const La = Dot(d1, d1);
+			F4 const Lb = Dot(d2, d2);
+			F4 const f = Dot(d2, r);
+			F4 const c = Dot(d1, r);
+			F4 const d = Dot(d1, d2);
+
+			F4 const a_degenerate = LessEqual(La, eps);
+			F4 const b_degenerate = LessEqual(Lb, eps);
+			F4 const safe_La = Select(a_degenerate, one, La);
+			F4 const safe_Lb = Select(b_degenerate, one, Lb);
+
+			// General nondegenerate case
+			F4 const denom = Sub(Mul(La, Lb), Mul(d, d));
+			F4 const has_denom = NotEqual(denom, Zero());
+			F4 s_gen = Select(has_denom,
+				Clamp01(Div(Sub(Mul(d, f), Mul(c, Lb)), Select(has_denom, denom, one))),
+				Zero());
+			F4 const t_gen = Div(Add(Mul(d, s_gen), f), safe_Lb);
+			s_gen = Select(Less(t_gen, Zero()), Clamp01(Div(Sub(Zero(), c), safe_La)),
+				Select(Greater(t_gen, one), Clamp01(Div(Sub(d, c), safe_La)), s_gen));
+
+			// Second segment is a point
+			F4 const s_b_point = Clamp01(Div(Sub(Zero(), c), safe_La));
+			// First segment is a point
+			F4 const t_a_point = Clamp01(Div(f, safe_Lb));
+
+			F4 const s = Select(a_degenerate, Zero(), Select(b_degenerate, s_b_point, s_gen));
+			F4 const t = Select(b_degenerate, Zero(), Select(a_degenerate, t_a_point, Clamp01(t_gen)));
+
+			for (Uint32 k = 0; k < 3; ++k) {
+				c1[k] = Add(a0[k], Mul(d1[k], s));
+				c2[k] = Add(b0[k], Mul(d2[k], t));
+			}
+		}
+
+		static void LoadLanes(Float32 const (&src)[3][WIDTH], F4 dst[3]) {
+			for (Uint32 k = 0; k < 3; ++k) {
+				dst[k] = Load(src[k]);
+			}
+		}
+
+		static ContactManifold ToManifold(ContactLanes const& lanes, Uint32 lane, Bool swapped) {
+			ContactManifold result{};
+			if (lanes.hit_mask & (1u << lane)) {
+				result.normal = GetLane(lanes.normal, lane);
+				result.contacts[result.num_contacts++] = Contact{
+					.position = GetLane(lanes.position, lane),
+					.penetration = lanes.penetration[lane]
+				};
+			}
+			if (swapped) {
+				result.normal *= -1.0f;
+			}
+			return result;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	// CONTACT BATCH
+	////////////////////////////////////////////////////////////////////////////
+
+	void ContactBatch::Clear() {
+		jobs.clear();
+		results.clear();
+		for (auto&& bucket : buckets) {
+			bucket.clear();
+		}
+	}
+
+	Uint32 ContactBatch::Add(Collider const* a, Collider const* b) {
+		SIK_ASSERT(a && b, "Colliders must be valid");
+
+		using Type = Collider::Type;
+		Type const ta = a->GetType();
+		Type const tb = b->GetType();
+
+		Bucket bucket = Bucket::GENERIC;
+		Bool swapped = false;
+
+		if (ta == Type::Sphere && tb == Type::Sphere) {
+			bucket = Bucket::SPHERE_SPHERE;
+		}
+		else if (ta == Type::Sphere && tb == Type::Capsule) {
+			bucket = Bucket::SPHERE_CAPSULE;
+		}
+		else if (ta == Type::Capsule && tb == Type::Sphere) {
+			bucket = Bucket::SPHERE_CAPSULE;
+			swapped = true;
+			std::swap(a, b);
+		}
+		else if (ta == Type::Capsule && tb == Type::Capsule) {
+			bucket = Bucket::CAPSULE_CAPSULE;
+		}
+
+		Uint32 const idx = Size();
+		jobs.push_back(Job{ a, b, swapped });
+		buckets[bucket].push_back(idx);
+		return idx;
+	}
+
+	void ContactBatch::Run() {
+		results.assign(jobs.size(), ContactManifold{});
+
+		RunSphereSphere();
+		RunSphereCapsule();
+		RunCapsuleCapsule();
+		RunGeneric();
+	}
+
+	void ContactBatch::RunSphereSphere() {
+		using namespace detail;
+		Vector<Uint32> const& bucket = buckets[Bucket::SPHERE_SPHERE];
+
+		for (SizeT base = 0; base < bucket.size(); base += WIDTH) {
+			Uint32 const n = static_cast<Uint32>(std::min<SizeT>(WIDTH, bucket.size() - base));
+
+			SphereLanes in{};
+			for (Uint32 i = 0; i < n; ++i) {
+				Job const& job = jobs[bucket[base + i]];
+				Sphere const* a = static_cast<Sphere const*>(job.a);
+				Sphere const* b = static_cast<Sphere const*>(job.b);
+				SetLane(in.pa, i, a->GetWorldPosition());
+				SetLane(in.pb, i, b->GetWorldPosition());
+				in.ra[i] = a->GetRadius();
+				in.rb[i] = b->GetRadius();
+			}
+
+			F4 pa[3], pb[3];
+			LoadLanes(in.pa, pa);
+			LoadLanes(in.pb, pb);
+
+			ContactLanes out;
+			CollideSpheres(pa, Load(in.ra), pb, Load(in.rb), out);
+
+			for (Uint32 i = 0; i < n; ++i) {
+				Uint32 const idx = bucket[base + i];
+				results[idx] = ToManifold(out, i, jobs[idx].swapped);
+			}
+		}
+	}
+
+	void ContactBatch::RunSphereCapsule() {
+		using namespace detail;
+		Vector<Uint32> const& bucket = buckets[Bucket::SPHERE_CAPSULE];
+
+		for (SizeT base = 0; base < bucket.size(); base += WIDTH) {
+			Uint32 const n = static_cast<Uint32>(std::min<SizeT>(WIDTH, bucket.size() - base));
+
+			// Sphere in a, capsule segment in b
+			SegmentLanes in{};
+			for (Uint32 i = 0; i < n; ++i) {
+				Job const& job = jobs[bucket[base + i]];
+				Sphere const* a = static_cast<Sphere const*>(job.a);
+				Capsule const* b = static_cast<Capsule const*>(job.b);
+				LineSegment const seg = b->GetCentralSegment();
+				SetLane(in.a0, i, a->GetWorldPosition());
+				SetLane(in.b0, i, seg.start);
+				SetLane(in.b1, i, seg.end);
+				in.ra[i] = a->GetRadius();
+				in.rb[i] = b->GetRadius();
+			}
+
+			F4 pa[3], b0[3], b1[3], pb[3];
+			LoadLanes(in.a0, pa);
+			LoadLanes(in.b0, b0);
+			LoadLanes(in.b1, b1);
+			ClosestPointOnSegment(pa, b0, b1, pb);
+
+			ContactLanes out;
+			CollideSpheres(pa, Load(in.ra), pb, Load(in.rb), out);
+
+			for (Uint32 i = 0; i < n; ++i) {
+				Uint32 const idx = bucket[base + i];
+				results[idx] = ToManifold(out, i, jobs[idx].swapped);
+			}
+		}
+	}
+
+	void ContactBatch::RunCapsuleCapsule() {
+		using namespace detail;
+		Vector<Uint32> const& bucket = buckets[Bucket::CAPSULE_CAPSULE];
+
+		for (SizeT base = 0; base < bucket.size(); base += WIDTH) {
+			Uint32 const n = static_cast<Uint32>(std::min<SizeT>(WIDTH, bucket.size() - base));
+
+			SegmentLanes in{};
+			for (Uint32 i = 0; i < n; ++i) {
+				Job const& job = jobs[bucket[base + i]];
+				Capsule const* a = static_cast<Capsule const*>(job.a);
+				Capsule const* b = static_cast<Capsule const*>(job.b);
+				LineSegment const seg_a = a->GetCentralSegment();
+				LineSegment const seg_b = b->GetCentralSegment();
+				SetLane(in.a0, i, seg_a.start);
+				SetLane(in.a1, i, seg_a.end);
+				SetLane(in.b0, i, seg_b.start);
+				SetLane(in.b1, i, seg_b.end);
+				in.ra[i] = a->GetRadius();
+				in.rb[i] = b->GetRadius();
+			}
+
+			F4 a0[3], a1[3], b0[3], b1[3], pa[3], pb[3];
+			LoadLanes(in.a0, a0);
+			LoadLanes(in.a1, a1);
+			LoadLanes(in.b0, b0);
+			LoadLanes(in.b1, b1);
+			ClosestPointsSegments(a0, a1, b0, b1, pa, pb);
+
+			F4 const ra = Load(in.ra);
+			F4 const rb = Load(in.rb);
+
+			ContactLanes out;
+			CollideSpheres(pa, ra, pb, rb, out);
+
+			// Separated capsules still report the separating normal
+			F4 const d[3] = { Sub(pb[0], pa[0]), Sub(pb[1], pa[1]), Sub(pb[2], pa[2]) };
+			F4 const d2 = Dot(d, d);
+			F4 const r_sum = Add(ra, rb);
+			Uint32 const separated_mask = MoveMask(Greater(d2, Mul(r_sum, r_sum)));
+
+			Float32 dist2[WIDTH];
+			Store(dist2, d2);
+
+			for (Uint32 i = 0; i < n; ++i) {
+				Uint32 const idx = bucket[base + i];
+				if (separated_mask & (1u << i)) {
+					results[idx] = ContactManifold{
+						.normal = dist2[i] > 0.0001f ? GetLane(out.normal, i) : Vec3(NAN)
+					};
+				}
+				else {
+					results[idx] = ToManifold(out, i, jobs[idx].swapped);
+				}
+			}
+		}
+	}
+
+	void ContactBatch::RunGeneric() {
+		for (Uint32 idx : buckets[Bucket::GENERIC]) {
+			Job const& job = jobs[idx];
+			results[idx] = job.a->Collide(job.b);
+		}
+	}
+}
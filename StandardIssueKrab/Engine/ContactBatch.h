@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Collision.h"
+
+namespace Collision {
+
+	/*
+	* Batched narrow phase. Collider pairs are queued after the broad phase and
+	* bucketed by their shape types. Sphere-sphere, sphere-capsule and
+	* capsule-capsule buckets run through SSE kernels which handle 4 pairs at a
+	* time, with segment closest points computed in SoA. Every other pair goes
+	* through Collider::Collide as before.
+	*
+	* Results match Collider::Collide for the same pair, including the normal
+	* direction for capsule-sphere pairs (which are solved as sphere-capsule and
+	* flipped).
+	*
+	* Usage per step:
+	*	batch.Clear();
+	*	Uint32 const idx = batch.Add(collider_a, collider_b);
+	*	...
+	*	batch.Run();
+	*	ContactManifold const& m = batch.Result(idx);
+	*/
+	class ContactBatch
+	{
+	public:
+		enum Bucket : Uint32 {
+			SPHERE_SPHERE = 0,
+			SPHERE_CAPSULE,
+			CAPSULE_CAPSULE,
+			GENERIC,
+
+			COUNT
+		};
+
+	private:
+		struct Job {
+			Collider const* a;
+			Collider const* b;
+			Bool swapped; // a and b were swapped to fit the bucket, so the normal is flipped
+		};
+
+		Vector<Job>				jobs;
+		Vector<ContactManifold> results;
+		Vector<Uint32>			buckets[Bucket::COUNT]; // job indices per bucket
+
+	public:
+		void Clear();
+
+		// Queues the pair and returns the index of its result
+		Uint32 Add(Collider const* a, Collider const* b);
+
+		// Computes manifolds for every queued pair
+		void Run();
+
+		inline ContactManifold const& Result(Uint32 idx) const { return results[idx]; }
+		inline Uint32 Size() const noexcept { return static_cast<Uint32>(jobs.size()); }
+		inline Uint32 BucketSize(Bucket b) const noexcept { return static_cast<Uint32>(buckets[b].size()); }
+
+	private:
+		void RunSphereSphere();
+		void RunSphereCapsule();
+		void RunCapsuleCapsule();
+		void RunGeneric();
+	};
+}
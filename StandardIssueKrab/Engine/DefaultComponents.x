@@ -1,2 +1,5 @@
 REGISTER_COMPONENT(TestComp)
-REGISTER_COMPONENT(TestComp2)
\ No newline at end of file
+REGISTER_COMPONENT(TestComp2)
+REGISTER_COMPONENT(TestWriterComp)
+REGISTER_COMPONENT(TestReaderComp)
+REGISTER_COMPONENT(TestMainThreadComp)
\ No newline at end of file
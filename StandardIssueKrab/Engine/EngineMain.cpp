@@ -2,6 +2,7 @@
 #include "EngineMain.h"
 
 #include "MemoryManager.h"
+#include "AllocationAudit.h"
 #include "MemoryResources.h"
 #include "GameManager.h"
 #include "FrameTimer.h"
@@ -67,9 +68,14 @@ StringDictionary* p_dbg_string_dictionary = nullptr;
 
 /*
 * Creates all global managers using the provided allocator.
+* Managers with a memory budget are constructed inside a ScopedResource for it,
+* so the containers they own allocate from (and are tracked by) their budget.
+* The manager objects themselves still come from alloc.
 * Returns : void
 */
 void CreateManagersUsingAllocator(PolymorphicAllocator alloc) {
+    using ScopedResource = MemoryManager::ScopedResource;
+
 #ifdef STR_DEBUG
     p_dbg_string_dictionary = alloc.new_object<StringDictionary>();
 #endif
@@ -78,16 +84,37 @@ void CreateManagersUsingAllocator(PolymorphicAllocator alloc) {
     p_game_manager = alloc.new_object<GameManager>();
     p_input_manager = alloc.new_object<InputManager>();
     p_audio_manager = alloc.new_object<AudioManager>();
-    p_graphics_manager = alloc.new_object<GraphicsManager>();
-    p_resource_manager = alloc.new_object<ResourceManager>();
+    {
+        ScopedResource scope{ MemoryBudget::Render };
+        p_graphics_manager = alloc.new_object<GraphicsManager>();
+    }
+    {
+        ScopedResource scope{ MemoryBudget::Resources };
+        p_resource_manager = alloc.new_object<ResourceManager>();
+    }
     p_game_obj_manager = alloc.new_object<GameObjectManager>();
     p_world_editor = alloc.new_object<WorldEditor>();
-    p_physics_manager = alloc.new_object<PhysicsManager>();
+    {
+        ScopedResource scope{ MemoryBudget::Physics };
+        p_physics_manager = alloc.new_object<PhysicsManager>();
+    }
     p_factory = alloc.new_object<Factory>();
-    p_particle_system = alloc.new_object<ParticleSystem>();
-    p_imgui_window = alloc.new_object<SIK::ImGuiWindow>();
-    p_scripting_manager = alloc.new_object<ScriptingManager>();
-    p_gui_object_manager = alloc.new_object<GUIObjectManager>();
+    {
+        ScopedResource scope{ MemoryBudget::Render };
+        p_particle_system = alloc.new_object<ParticleSystem>();
+    }
+    {
+        ScopedResource scope{ MemoryBudget::GUI };
+        p_imgui_window = alloc.new_object<SIK::ImGuiWindow>();
+    }
+    {
+        ScopedResource scope{ MemoryBudget::Scripting };
+        p_scripting_manager = alloc.new_object<ScriptingManager>();
+    }
+    {
+        ScopedResource scope{ MemoryBudget::GUI };
+        p_gui_object_manager = alloc.new_object<GUIObjectManager>();
+    }
     p_gamestate_manager = alloc.new_object<GameStateManager>();
 }
 
@@ -166,6 +193,7 @@ bool EngineInit() {
         DebugMemoryResource::Flag::TrackOnly,
         std::pmr::new_delete_resource());
     std::pmr::set_default_resource(noisy_allocator.get());
+    AllocationAudit::Watch(noisy_allocator.get());
 #endif
 
     //Initialize LogManager
@@ -177,6 +205,9 @@ bool EngineInit() {
     // Maybe set the current allocator to something different for
     // the rest of managers
 
+    // Scratch memory for data which only lives for a frame
+    p_memory_manager->CreateFrameResource(8 * 1024 * 1024);
+
     //Construct managers
     PolymorphicAllocator managers_allocator = p_memory_manager->GetCurrentAllocator();
     CreateManagersUsingAllocator(managers_allocator);
@@ -231,6 +262,7 @@ void EngineCleanup() {
     p_memory_manager = nullptr;
 
 #ifdef MEM_DEBUG
+    AllocationAudit::Unwatch(noisy_allocator.get());
     std::pmr::set_default_resource(nullptr);
     noisy_allocator.reset();
 #endif
@@ -307,9 +339,12 @@ int EngineMain(int argc, char* args[], bool run_prototypes) {
             p_input_manager->Update();
             p_audio_manager->Update();
 
+            p_game_obj_manager->GetTickScheduler().BeginFrame(dt);
+
             // Physics Update
             while (accumulator >= fixed_time_step) {
-                p_physics_manager->Update(fixed_dt);
+                p_game_obj_manager->GetTickScheduler().BeginFixedStep(fixed_dt);
+                p_physics_manager->Update(fixed_dt, p_graphics_manager->GetPActiveCam());
                 p_gamestate_manager->FixedUpdate(fixed_dt);
                 accumulator -= fixed_time_step;
             }
@@ -323,6 +358,9 @@ int EngineMain(int argc, char* args[], bool run_prototypes) {
 #endif // _PROTOTYPE
             p_gamestate_manager->Update(dt);
 
+            // World matrices, once physics and gameplay have moved everything
+            p_game_obj_manager->UpdateWorldMatrices();
+
             // Rendering
             p_particle_system->Update(dt);
             p_graphics_manager->Update(dt);
@@ -337,6 +375,8 @@ int EngineMain(int argc, char* args[], bool run_prototypes) {
 
             // Frame End
             p_game_obj_manager->CleanupDeletedObjects();
+            p_memory_manager->SwapFrameBuffers();
+            AllocationAudit::FrameEnd();
             p_frame_rate_manager->FrameEnd(dt);
         }
     }
@@ -15,6 +15,11 @@ Compilation macros:
 	MEM_DEBUG: sets the default allocator to a "noisy" wrapper around new_delete_resource,
 		and calls _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF) to track
 		memory leaks.
+
+	ALLOC_AUDIT: replaces global operator new and delete to count allocations per frame,
+		so AllocationAudit can report frames which allocate after warmup. The audit's
+		mode is Off by default, which only counts. Debug only, since the reports are
+		logged and Release compiles logging out.
 */
 
 
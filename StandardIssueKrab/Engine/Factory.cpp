@@ -3,6 +3,7 @@
 
 #include "ResourceManager.h"
 #include "MemoryManager.h"
+#include "AllocationAudit.h"
 #include "GameObjectManager.h"
 #include "GraphicsManager.h"
 #include "PhysicsManager.h"
@@ -25,10 +26,47 @@
 
 static Bool CreateEngineSideComponent(GameObject* go, StringID comp_id, rapidjson::Value const& rj_value);
 static void ModifyEngineSideComponent(GameObject* go, StringID comp_id, rapidjson::Value const& rj_value);
+static void AddTags(GameObject* go, rapidjson::Value const& rj_value);
 
 Factory::Factory() {}
 
 GameObject* Factory::BuildGameObject(const char* filename) {
+	StringID const archetype = ToStringID(filename);
+	GameObject* p_obj = p_game_obj_manager->TakeRecycled(archetype);
+	if (p_obj) { return p_obj; }
+
+	p_obj = BuildFromFile(filename);
+	if (p_obj) {
+		p_game_obj_manager->SetArchetype(p_obj, archetype);
+	}
+	return p_obj;
+}
+
+void Factory::WarmRecyclePool(const char* filename, Uint32 warm_count, Uint32 max_size) {
+	StringID const archetype = ToStringID(filename);
+	p_game_obj_manager->SetRecycleLimit(archetype, max_size);
+
+	warm_count = std::min(warm_count, max_size);
+	SizeT const pooled = p_game_obj_manager->RecycledCount(archetype);
+	if (pooled >= warm_count) { return; }
+
+	// Build them all before deleting any, or each one would be recycled
+	Vector<GameObject*> warm_objects;
+	warm_objects.reserve(warm_count - pooled);
+	for (SizeT i = pooled; i < warm_count; ++i) {
+		GameObject* p_obj = BuildFromFile(filename);
+		if (p_obj == nullptr) { break; }
+		p_game_obj_manager->SetArchetype(p_obj, archetype);
+		warm_objects.push_back(p_obj);
+	}
+	for (GameObject* p_obj : warm_objects) {
+		p_game_obj_manager->DeleteGameObject(p_obj);
+	}
+}
+
+// Always builds a new object. Objects built from an archetype by a scene
+// file are modified afterwards, so they must not come from its recycle pool.
+GameObject* Factory::BuildFromFile(const char* filename) {
 	JSON* json{ p_resource_manager->LoadJSON(filename) };
 	if (json == nullptr) {
 		SIK_ERROR("JSON document has not yet been loaded: {}", filename);
@@ -49,7 +87,7 @@ GameObject* Factory::BuildGameObject(rapidjson::Document& val) {
 	
 	doc_itr = val.FindMember("Archetype");
 	if (doc_itr != val.MemberEnd()) {
-		p_obj = BuildGameObject(doc_itr->value.GetString());
+		p_obj = BuildFromFile(doc_itr->value.GetString());
 		
 		// override object name in Archetype
 		doc_itr = val.FindMember("Name");
@@ -103,6 +141,12 @@ GameObject* Factory::BuildGameObject(rapidjson::Document& val) {
 		}
 	}
 
+	// An object's tags are added to those of its archetype
+	doc_itr = val.FindMember("Tags");
+	if (doc_itr != val.MemberEnd()) {
+		AddTags(p_obj, doc_itr->value);
+	}
+
 	/*
 	* Linking step
 	* Links related components after they have all been added to the game object
@@ -187,6 +231,13 @@ Vector<GameObject*> Factory::BuildScene(const char* filename) {
 	std::filesystem::path curr_scene = std::filesystem::current_path() / ".." / "StandardIssueKrab" / "Engine" / "Assets" / "JSON" / filename;
 	p_world_editor->SetOpenFileName(curr_scene.string().c_str());
 
+	// Building a scene allocates, and so do its first frames
+	AllocationAudit::Rearm();
+
+	// The previous scene's renderers are freed during the next cleanup, so
+	// compact the new scene's into their slots then
+	p_graphics_manager->RequestRendererCompaction();
+
 	return to_return;
 }
 
@@ -400,3 +451,12 @@ Component* Factory::GetGameSideComp(StringID comp_id) {
 
 	return nullptr;
 }
+
+// Adds the tags from a JSON array of strings, e.g. "Tags": [ "Enemy", "Magnetic" ]
+static void AddTags(GameObject* go, rapidjson::Value const& rj_value) {
+	SIK_ASSERT(rj_value.IsArray(), "Tags must be an array of strings.");
+	for (auto const& tag : rj_value.GetArray()) {
+		SIK_ASSERT(tag.IsString(), "Tag must be a string.");
+		go->AddTag(ToStringID(tag.GetString()));
+	}
+}
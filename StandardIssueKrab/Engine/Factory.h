@@ -2,6 +2,7 @@
 
 #include "Component.h"
 #include "MemoryManager.h"
+#include "GameObjectManager.h"
 
 class GameObject;
 
@@ -12,6 +13,7 @@ class Factory {
 
 private:
 	void SaveObjectInScene(rapidjson::Document& doc, GameObject const& go);
+	GameObject* BuildFromFile(const char* filename);
 
 public:
 	Factory();
@@ -25,8 +27,14 @@ public:
 	template<ValidComponent C>
 	void RegisterComponent();
 	
+	// Hands back a recycled object of the archetype if its pool has one
 	GameObject* BuildGameObject(const char* filename);
 	GameObject* BuildGameObject(rapidjson::Document& val);
+
+	// Builds and deletes objects of the archetype until its recycle pool holds
+	// warm_count of them, and keeps at most max_size once they are deleted.
+	// Call it while loading, so spawning them later does not build anything.
+	void WarmRecyclePool(const char* filename, Uint32 warm_count, Uint32 max_size);
 	void SaveObjectArchetype(const char* archetype_filename, GameObject const& go);
 
 	Vector<GameObject*> BuildScene(const char* filename);
@@ -38,10 +46,13 @@ public:
 extern Factory* p_factory;
 
 
-// Better way to do this?
+// Components live in their type's column of the component storage, which is
+// in the scene resource. Only the component itself: what it allocates in its
+// constructor (e.g. an InputAction) still comes from the current allocator,
+// which it frees with.
 template<ValidComponent C>
 Component* Builder() {
-	return MemoryManager::GetDefaultAllocator().new_object<C>();
+	return p_game_obj_manager->GetComponentStorage().Create<C>();
 }
 
 // Inline definitions
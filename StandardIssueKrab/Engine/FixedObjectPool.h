@@ -16,21 +16,33 @@ This is a simplified version which differs from the original:
 -- only compatible with C++20 and not tested on compilers except MSVC
 -- only uses a fixed size, static array for backing buffer instead of dynamically growing
 -- only inserts into the first node of each skipblock
--- does not use iterators (unfortunately) and instead is iterable using a range, e.g.,
+
+It is iterable with forward iterators (so std algorithms work), or with a range.
+The element at the front of a range may be erased before calling pop_front, but
+no other element:
 
 	FixedObjectPool<T, N> fop;
 	// ... insert elements ...
 
-	for(auto range = fop; not range.is_empty(); range.pop_front()) {
+	for(auto range = fop.all(); not range.is_empty(); range.pop_front()) {
 		T& element = range.front();
 		// ... read/write elements ...
 	}
 
+A range can be split into disjoint sub-ranges to iterate in parallel:
+
+	std::array<FixedObjectPool<T, N>::range, 8> parts;
+	fop.split(parts.size(), parts.begin());
+	std::for_each(std::execution::par, parts.begin(), parts.end(), [](auto part) {
+		for (T& element : part) { ... }
+	});
+
+batch_insert and batch_erase update the skipfield and free list once per
+skipblock (insert) or once per batch (erase) instead of once per element.
+
 TODOs:
 -- implement copy/move constructors and assignment operators
 -- debug insertion pattern after erasures (on rare occassions inserts into the middle of freeblocks and hits assertion...)
--- implement batch_insert and batch_erase methods
--- add support for iterators (and thus for C++ std algorithms)
 */
 
 /*
@@ -54,6 +66,9 @@ This notice may not be removed or altered from any source distribution.
 #include <utility>
 #include <memory>
 #include <array>
+#include <functional>
+#include <iterator>
+#include <algorithm>
 
 #ifndef _ENABLE_EXTENDED_ALIGNED_STORAGE
 #define _ENABLE_EXTENDED_ALIGNED_STORAGE
@@ -104,6 +119,11 @@ public:
 	friend fop_range<false>;
 	friend fop_range<true>;
 
+	// Iterator support
+	template<bool is_const> class fop_iterator;
+	using iterator = fop_iterator<false>;
+	using const_iterator = fop_iterator<true>;
+
 private:
 	// Internal storage
 	struct alignas(alignof(aligned_element_type)) dummy_type 
@@ -125,8 +145,12 @@ private:
 private:
 	static constexpr skipfield_type k_skipfield_max = std::numeric_limits<skipfield_type>::max();
 
+	// batch_erase rebuilds the skipfield in one pass when it erases at least
+	// 1/k_batch_rebuild_ratio of the used slots, otherwise it erases one by one
+	static constexpr size_type k_batch_rebuild_ratio = 16;
+
 	std::array<dummy_type, N> elements = {};			// Buffer to contain all elements AND in-place free-list
-	std::array<skipfield_type, N> skipfield = {};		// "Low Complexity Jump Counting" skipfield
+	std::array<skipfield_type, N + 1> skipfield = {};	// "Low Complexity Jump Counting" skipfield, plus a 0 sentinel so iteration never reads past the end
 	skipfield_type total_size = 0;						// Number of active elements
 	skipfield_type first_occupied_index = N;			// Index of the first active element. Value >=N  ==>  no occupied slots.
 	skipfield_type free_list_head = k_skipfield_max;	// Index of the most recently erased slot. Value == k_skipfield_max  ==>  free list is empty.
@@ -509,8 +533,10 @@ public:
 			skipfield_pointer end = skip_ptr + right;
 			*end = left + right + 1;
 
-			// Ensure that no nodes in a skipblock have value 0
-			*skip_ptr = 1;
+			// Ensure that no nodes in a skipblock have value 0. Middle node
+			// values are otherwise unused, so store the jump to the end of the
+			// block for a range which is currently on this node (see pop_front)
+			*skip_ptr = right + 1;
 
 			// Next element is at the index == end node's index + 1
 			next = curr_index + right + 1;
@@ -625,6 +651,66 @@ public:
 		return (next >= N) ? nullptr : index_to_elem_ptr(next);
 	}
 
+	// Copies [first, last) into the pool, filling a whole free skipblock at a
+	// time. Returns the number of elements inserted, which is less than
+	// distance(first, last) only if the pool became full.
+	template<std::forward_iterator It>
+	size_type batch_insert(It first, It last) {
+		return batch_construct(static_cast<size_type>(std::distance(first, last)), [&first](pointer p) {
+			std::construct_at<value_type>(p, *first);
+			++first;
+		});
+	}
+
+	// Inserts count copies of val. Returns the number of elements inserted.
+	size_type batch_insert(size_type count, const_reference val) {
+		return batch_construct(count, [&val](pointer p) {
+			std::construct_at<value_type>(p, val);
+		});
+	}
+
+	// Erases every element pointed to by [first, last). Pointers to slots which
+	// are already erased are ignored. Returns the number of elements erased.
+	template<std::forward_iterator It>
+		requires std::convertible_to<std::iter_reference_t<It>, pointer>
+	size_type batch_erase(It first, It last) {
+		size_type const count = static_cast<size_type>(std::distance(first, last));
+		size_type const used_end = used_slots();
+		size_type const size_before = total_size;
+
+		// Small batch: not worth a pass over the skipfield
+		if (count * k_batch_rebuild_ratio < used_end) {
+			for (; first != last; ++first) {
+				erase(*first);
+			}
+			return size_before - total_size;
+		}
+
+		for (; first != last; ++first) {
+			pointer const p_val = *first;
+			assert(p_val != nullptr && contains(p_val));
+
+			dummy_pointer const slot_ptr = convert_ptr<dummy_pointer>(p_val);
+			skipfield_type const index = slot_ptr_to_index(slot_ptr);
+			if (skipfield[index] != 0) { continue; } // double delete
+
+			std::destroy_at<value_type>(p_val);
+			*slot_ptr = {}; // Zero the slot
+			skipfield[index] = 1; // Any non-zero value marks it skipped until the rebuild
+			--total_size;
+		}
+
+		if (total_size == 0) {
+			skipfield = {};
+			first_occupied_index = N;
+			free_list_head = k_skipfield_max;
+		}
+		else {
+			rebuild_skipblocks(static_cast<skipfield_type>(used_end));
+		}
+		return size_before - total_size;
+	}
+
 	void clear() {
 		destroy_all_data();
 		skipfield = {}; // Zero the skipfield
@@ -649,11 +735,148 @@ public:
 		};
 	}
 
+	iterator begin()				{ return iterator{ all() }; }
+	iterator end()					{ return iterator{}; }
+	const_iterator begin() const	{ return const_iterator{ all() }; }
+	const_iterator end() const		{ return const_iterator{}; }
+	const_iterator cbegin() const	{ return begin(); }
+	const_iterator cend() const		{ return end(); }
+
+	// Writes n disjoint ranges covering every element to out (see fop_range::split)
+	template<std::output_iterator<range> OutIt>
+	OutIt split(size_type n, OutIt out) {
+		return all().split(n, out);
+	}
+
+	template<std::output_iterator<const_range> OutIt>
+	OutIt split(size_type n, OutIt out) const {
+		return all().split(n, out);
+	}
+
 	size_type size() const noexcept	    { return total_size; }
 	
 	size_type capacity() const noexcept { return N; }
 
+	bool full() const noexcept			{ return total_size == N; }
+
+	// True if p_val points into this pool's buffer, whether or not that slot is occupied
+	bool contains(const_pointer p_val) const noexcept {
+		const void* p = p_val;
+		return not std::less<const void*>{}(p, elements.data()) &&
+			std::less<const void*>{}(p, elements.data() + N);
+	}
+
 private:
+	// Number of slots up to the end of the last skipblock or element. Slots
+	// past this have never been used.
+	size_type used_slots() const noexcept {
+		size_type skipped = 0;
+		for (skipfield_type head = free_list_head; head != k_skipfield_max; head = index_to_free_list_ptr(head)->next) {
+			skipped += skipfield[head];
+		}
+		return total_size + skipped;
+	}
+
+	// Fills free skipblocks from the free list first, then the never-used slots
+	// at the end. construct(pointer) constructs one element at the address.
+	template<class Construct>
+	size_type batch_construct(size_type count, Construct&& construct) {
+		assert(count <= N - total_size);
+		count = std::min(count, N - total_size);
+
+		size_type remaining = count;
+		while (remaining > 0 && free_list_head != k_skipfield_max) {
+			skipfield_type const start = free_list_head;
+			skipfield_type const block_length = skipfield[start];
+			skipfield_type const fill = static_cast<skipfield_type>(std::min<size_type>(block_length, remaining));
+
+			// Copy the block's free list node before constructing over it
+			free_list_pointer const start_node = index_to_free_list_ptr(start);
+			free_list_node const node = *start_node;
+			*start_node = {};
+
+			if (fill < block_length) {
+				// The rest of the block becomes a shorter block, and keeps its
+				// place at the head of the free list
+				skipfield_type const new_start = start + fill;
+				skipfield_type const new_length = block_length - fill;
+				skipfield[new_start] = new_length;
+				skipfield[start + block_length - 1] = new_length;
+
+				*index_to_free_list_ptr(new_start) = node;
+				free_list_head = new_start;
+				if (node.next != k_skipfield_max) {
+					index_to_free_list_ptr(node.next)->prev = new_start;
+				}
+			}
+			else {
+				free_list_head = node.next;
+				if (node.next != k_skipfield_max) {
+					index_to_free_list_ptr(node.next)->prev = k_skipfield_max;
+				}
+			}
+
+			std::fill_n(skipfield.begin() + start, fill, skipfield_type{ 0 });
+			for (skipfield_type i = 0; i < fill; ++i) {
+				construct(index_to_elem_ptr(start + i));
+			}
+
+			if (start < first_occupied_index) { first_occupied_index = start; }
+			total_size += fill;
+			remaining -= fill;
+		}
+
+		// With an empty free list, every slot before total_size is occupied
+		if (remaining > 0) {
+			if (total_size == 0) { first_occupied_index = 0; }
+			for (size_type i = 0; i < remaining; ++i) {
+				construct(index_to_elem_ptr(static_cast<skipfield_type>(total_size + i)));
+			}
+			total_size += static_cast<skipfield_type>(remaining);
+		}
+
+		return count;
+	}
+
+	// Rebuilds the skipblocks and free list of [0, used_end) from scratch. Any
+	// non-zero skipfield value is treated as a skipped slot. The free list ends
+	// up in index order, so inserts fill the lowest slots first.
+	void rebuild_skipblocks(skipfield_type used_end) {
+		free_list_head = k_skipfield_max;
+		first_occupied_index = N;
+		skipfield_type prev_start = k_skipfield_max;
+
+		skipfield_type i = 0;
+		while (i < used_end) {
+			if (skipfield[i] == 0) {
+				if (first_occupied_index == N) { first_occupied_index = i; }
+				++i;
+				continue;
+			}
+
+			skipfield_type end = i;
+			while (end < used_end && skipfield[end] != 0) { ++end; }
+
+			// Only the start and end nodes need the length, the middle ones just
+			// need to be non-zero (which they already are)
+			skipfield_type const length = end - i;
+			skipfield[i] = length;
+			skipfield[end - 1] = length;
+
+			free_list_pointer const node = index_to_free_list_ptr(i);
+			node->prev = prev_start;
+			node->next = k_skipfield_max;
+			if (prev_start == k_skipfield_max) {
+				free_list_head = i;
+			}
+			else {
+				index_to_free_list_ptr(prev_start)->next = i;
+			}
+			prev_start = i;
+			i = end;
+		}
+	}
+
 	void destroy_all_data() {
 		range whole_container = all();
 		while (!whole_container.is_empty()) {
@@ -778,7 +1001,12 @@ public:
 			return length == 0; 
 		}
 
-		reference front() { 
+		size_type size() const noexcept {
+			return length;
+		}
+
+		// A range is a view, so front() does not need a non-const range
+		reference front() const { 
 			assert(!is_empty());
 			return *elem_ptr; 
 		}
@@ -786,14 +1014,24 @@ public:
 		void pop_front() {
 			assert(!is_empty());
 
-			// Read the next skip and increment skip ptr
-			skipfield_type skip = *(++skip_ptr);
+			// Jump over the next skipblock, if any
+			skipfield_type const next_skip = *(skip_ptr + 1);
+			size_type jump = next_skip + 1;
+
+			// The front element was erased while iterating and joined the next
+			// skipblock, so its node now starts or sits in the middle of that
+			// block and holds the jump to its end. The next node cannot be
+			// used, since it may have become the end node holding the length
+			// of the merged block. (If the front became the end of a block
+			// instead, the next node is occupied and the usual jump applies.)
+			if (*skip_ptr != 0 && next_skip != 0) {
+				jump = *skip_ptr;
+			}
 
-			// Skip forward
-			skip_ptr += skip;
+			skip_ptr += jump;
 
 			dummy_pointer ptr = convert_ptr<dummy_pointer>(elem_ptr);
-			ptr += skip + 1;
+			ptr += jump;
 
 			// Convert back
 			elem_ptr = convert_ptr<pointer>(ptr);
@@ -801,6 +1039,37 @@ public:
 			// Decrement length
 			--length;
 		}
+
+		// Removes the first count elements from this range and returns them as
+		// a range of their own. Only walks the skipfield.
+		fop_range split_front(size_type count) {
+			assert(count <= length);
+
+			fop_range front_part{ elem_ptr, skip_ptr, static_cast<skipfield_type>(count) };
+			for (size_type i = 0; i < count; ++i) {
+				pop_front();
+			}
+			return front_part;
+		}
+
+		// Writes n disjoint ranges, whose lengths differ by at most 1, covering
+		// this whole range to out. Costs one walk over the skipfield.
+		template<std::output_iterator<fop_range> OutIt>
+		OutIt split(size_type n, OutIt out) const {
+			assert(n > 0);
+
+			fop_range rest = *this;
+			size_type const base = length / n;
+			size_type const extra = length % n;
+			for (size_type i = 0; i < n; ++i) {
+				*out = rest.split_front(base + (i < extra ? 1 : 0));
+				++out;
+			}
+			return out;
+		}
+
+		fop_iterator<is_const> begin() const noexcept { return fop_iterator<is_const>{ *this }; }
+		fop_iterator<is_const> end() const noexcept { return fop_iterator<is_const>{}; }
 		
 
 	private:
@@ -812,6 +1081,58 @@ public:
 		{}
 	};
 
+
+	// Forward iterator which jumps over erased slots. Wraps the range of
+	// elements left to visit, so two iterators are equal when the same number of
+	// elements are left, and end() is any empty range.
+	template<bool is_const>
+	class fop_iterator
+	{
+	public:
+		friend class FixedObjectPool;
+		template<bool> friend class fop_iterator;
+
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = typename FixedObjectPool::value_type;
+		using difference_type = typename FixedObjectPool::difference_type;
+		using pointer = typename std::conditional_t<is_const, typename FixedObjectPool::const_pointer, typename FixedObjectPool::pointer>;
+		using reference = typename std::conditional_t<is_const, typename FixedObjectPool::const_reference, typename FixedObjectPool::reference>;
+
+	private:
+		fop_range<is_const> remaining = {};
+
+	public:
+		fop_iterator() noexcept = default;
+
+		explicit fop_iterator(fop_range<is_const> const& r) noexcept
+			: remaining{ r }
+		{}
+
+			// Converting from iterator to const_iterator
+		template<bool is_const_r = is_const, class = std::enable_if_t<is_const_r>>
+		fop_iterator(const fop_iterator<false>& src) noexcept
+			: remaining{ src.remaining }
+		{}
+
+		reference operator*() const { return remaining.front(); }
+		pointer operator->() const { return std::addressof(remaining.front()); }
+
+		fop_iterator& operator++() {
+			remaining.pop_front();
+			return *this;
+		}
+
+		fop_iterator operator++(int) {
+			fop_iterator tmp = *this;
+			remaining.pop_front();
+			return tmp;
+		}
+
+		friend bool operator==(fop_iterator const& l, fop_iterator const& r) noexcept {
+			return l.remaining.size() == r.remaining.size();
+		}
+	};
+
 #ifdef FOP_DEBUG
 	public:
 		template<class T, std::size_t N>
@@ -1,2 +1,223 @@
 #include "stdafx.h"
-#include "ForceGenerators.h"
\ No newline at end of file
+#include "ForceGenerators.h"
+
+#include "SIMD.h"
+#include "RigidBody.h"
+#include "MotionProperties.h"
+
+using namespace SIMD;
+
+// SoA streams used while accumulating one field's forces
+enum FieldLane : Uint32 {
+	PX, PY, PZ, MASS, INV_MASS, FX, FY, FZ,
+	LANE_COUNT
+};
+
+static F4 Falloff(ForceFalloff falloff, F4 t) {
+	F4 const one = Splat(1.0f);
+
+	switch (falloff) {
+	break; case ForceFalloff::Constant: {
+		return one;
+	}
+	break; case ForceFalloff::Linear: {
+		return Sub(one, t);
+	}
+	break; case ForceFalloff::Quadratic: {
+		F4 const s = Sub(one, t);
+		return Mul(s, s);
+	}
+	break; case ForceFalloff::Smooth: {
+		// 1 - (3t^2 - 2t^3)
+		F4 const t2 = Mul(t, t);
+		return Sub(one, Sub(Mul(Splat(3.0f), t2), Mul(Splat(2.0f), Mul(t2, t))));
+	}
+	break; default: {
+		SIK_ASSERT(false, "Invalid falloff.");
+	}
+	}
+	return one;
+}
+
+// v / |v|, or 0 where v is too short to have a direction
+static void SafeNormalize(F4 v[3]) {
+	F4 const len = Sqrt(Dot(v, v));
+	F4 const valid = Greater(len, Splat(0.0001f));
+	F4 const inv_len = Select(valid, Div(Splat(1.0f), Select(valid, len, Splat(1.0f))), Zero());
+	for (Uint32 k = 0; k < 3; ++k) {
+		v[k] = Mul(v[k], inv_len);
+	}
+}
+
+
+// Steps a body skipped by its LOD this update anyway, so an impulse moves it
+// now, with the time it has skipped, instead of when it next steps or never
+static void Wake(RigidBody& rb, Float32 time_step) {
+	if (rb.IsSteppedThisUpdate()) { return; }
+
+	rb.lod_step_dt = glm::max(rb.lod_pending_dt, time_step);
+	rb.lod_pending_dt = 0.0f;
+}
+
+
+ForceFieldID ForceFieldRegistry::Add(ForceField const& field) {
+	SIK_ASSERT(field.radius > 0.0f, "Force field radius must be positive.");
+
+	Entry entry{ .id = next_id++, .field = field };
+	if (glm::length2(entry.field.direction) > 0.0001f) {
+		entry.field.direction = glm::normalize(entry.field.direction);
+	}
+	else if (field.type != ForceField::Type::Radial) {
+		SIK_WARN("Force field direction is zero, so it will not apply any force.");
+	}
+
+	fields.push_back(entry);
+	return entry.id;
+}
+
+ForceFieldID ForceFieldRegistry::AddExplosion(Vec3 const& center, Float32 radius, Float32 impulse, ForceFalloff falloff) {
+	return Add(ForceField{
+		.type = ForceField::Type::Radial,
+		.mode = ForceField::Mode::Impulse,
+		.falloff = falloff,
+		.center = center,
+		.radius = radius,
+		.strength = impulse
+		});
+}
+
+Bool ForceFieldRegistry::Remove(ForceFieldID id) {
+	return std::erase_if(fields, [id](Entry const& e) { return e.id == id; }) > 0;
+}
+
+ForceField* ForceFieldRegistry::Find(ForceFieldID id) {
+	auto it = std::find_if(fields.begin(), fields.end(), [id](Entry const& e) { return e.id == id; });
+	return it != fields.end() ? &it->field : nullptr;
+}
+
+void ForceFieldRegistry::Clear() {
+	fields.clear();
+	overlaps.clear();
+}
+
+Uint32 ForceFieldRegistry::Apply(Collision::BVHierarchy const& bvh, Float32 time_step) {
+	Uint32 interactions = 0;
+
+	for (Entry const& entry : fields) {
+		ForceField const& field = entry.field;
+		Bool const is_impulse = field.mode == ForceField::Mode::Impulse;
+
+		overlaps.clear();
+		bvh.Query(field.radius, field.center, [this, &field, is_impulse](Collision::BVHNode const& node) {
+			RigidBody* rb = static_cast<RigidBody*>(node.bv.userData);
+			SIK_ASSERT(rb, "RigidBody was nullptr");
+			if (not (rb->IsDynamic() && rb->motion_props && rb->IsEnabled())) { return true; }
+			if ((field.layer_mask & RigidBody::LayerBit(rb->layer)) == 0) { return true; }
+
+			Bool const frozen = not rb->IsSteppedThisUpdate() && rb->sim_lod == RigidBody::SimLOD::Frozen;
+			if (is_impulse || not frozen) {
+				overlaps.push_back(rb);
+			}
+			return true;
+		});
+
+		if (overlaps.empty()) { continue; }
+
+		if (is_impulse) {
+			for (RigidBody* rb : overlaps) {
+				Wake(*rb, time_step);
+			}
+		}
+
+		Accumulate(field);
+		interactions += static_cast<Uint32>(overlaps.size());
+	}
+
+	// Impulses act once, timed fields expire
+	std::erase_if(fields, [time_step](Entry& e) {
+		if (e.field.mode == ForceField::Mode::Impulse) { return true; }
+		if (e.field.duration == ForceField::PERSISTENT) { return false; }
+		e.field.duration -= time_step;
+		return e.field.duration <= 0.0f;
+	});
+
+	return interactions;
+}
+
+void ForceFieldRegistry::Accumulate(ForceField const& field) {
+	Uint32 const count = static_cast<Uint32>(overlaps.size());
+	Uint32 const padded = (count + WIDTH - 1) / WIDTH * WIDTH;
+
+	lanes.assign(static_cast<SizeT>(LANE_COUNT) * padded, 0.0f);
+	auto lane = [this, padded](FieldLane l) { return lanes.data() + static_cast<SizeT>(l) * padded; };
+
+	for (Uint32 i = 0; i < count; ++i) {
+		RigidBody const& rb = *overlaps[i];
+		lane(PX)[i] = rb.position.x;
+		lane(PY)[i] = rb.position.y;
+		lane(PZ)[i] = rb.position.z;
+		lane(MASS)[i] = rb.motion_props->mass;
+		lane(INV_MASS)[i] = rb.motion_props->inv_mass;
+	}
+
+	F4 const center[3] = { Splat(field.center.x), Splat(field.center.y), Splat(field.center.z) };
+	F4 const dir[3] = { Splat(field.direction.x), Splat(field.direction.y), Splat(field.direction.z) };
+	F4 const strength = Splat(field.strength);
+	F4 const inv_radius = Splat(1.0f / field.radius);
+
+	for (Uint32 i = 0; i < padded; i += WIDTH) {
+		F4 const r[3] = {
+			Sub(Load(lane(PX) + i), center[0]),
+			Sub(Load(lane(PY) + i), center[1]),
+			Sub(Load(lane(PZ) + i), center[2])
+		};
+		F4 const dist = Sqrt(Dot(r, r));
+
+		F4 magnitude = Mul(strength, Falloff(field.falloff, Clamp01(Mul(dist, inv_radius))));
+		if (field.scale_by_mass) {
+			magnitude = Mul(magnitude, Load(lane(MASS) + i));
+		}
+		if (field.mode == ForceField::Mode::Impulse) {
+			// Impulses are applied as a change in velocity
+			magnitude = Mul(magnitude, Load(lane(INV_MASS) + i));
+		}
+
+		F4 n[3];
+		switch (field.type) {
+		break; case ForceField::Type::Radial: {
+			n[0] = r[0]; n[1] = r[1]; n[2] = r[2];
+			SafeNormalize(n);
+		}
+		break; case ForceField::Type::Directional: {
+			n[0] = dir[0]; n[1] = dir[1]; n[2] = dir[2];
+		}
+		break; case ForceField::Type::Vortex: {
+			// Tangent around the axis: axis x r
+			n[0] = Sub(Mul(dir[1], r[2]), Mul(dir[2], r[1]));
+			n[1] = Sub(Mul(dir[2], r[0]), Mul(dir[0], r[2]));
+			n[2] = Sub(Mul(dir[0], r[1]), Mul(dir[1], r[0]));
+			SafeNormalize(n);
+		}
+		break; default: {
+			SIK_ASSERT(false, "Invalid force field type.");
+			n[0] = n[1] = n[2] = Zero();
+		}
+		}
+
+		Store(lane(FX) + i, Mul(n[0], magnitude));
+		Store(lane(FY) + i, Mul(n[1], magnitude));
+		Store(lane(FZ) + i, Mul(n[2], magnitude));
+	}
+
+	Bool const is_impulse = field.mode == ForceField::Mode::Impulse;
+	for (Uint32 i = 0; i < count; ++i) {
+		MotionProperties& mp = *overlaps[i]->motion_props;
+		Vec3 const f{ lane(FX)[i], lane(FY)[i], lane(FZ)[i] };
+		if (is_impulse) {
+			mp.linear_velocity += f;
+		}
+		else {
+			mp.accumulated_force += f;
+		}
+	}
+}
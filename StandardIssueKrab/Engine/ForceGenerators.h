@@ -1,15 +1,101 @@
 #pragma once
 
+#include "BVHierarchy.h"
+
 struct RigidBody;
 
-struct ForceGenerator 
+/*
+* Spatial force fields (magnets, explosions, wind, vortices) applied by the
+* PhysicsManager once per step, before integration.
+*
+* Each field affects the dynamic bodies whose bounds overlap its sphere of
+* influence. Affected bodies are found with one BVH query per field, then the
+* field's force on every one of them is computed 4 bodies at a time and added to
+* their accumulated force (or velocity, for impulses).
+*
+* Bodies at a reduced simulation rate (see RigidBody::SimLOD) get a field's
+* force on every step, including the ones they skip, and average it over the
+* steps they make up. Frozen bodies drop forces, so fields skip them. Impulses
+* act once, so every body they reach is stepped this update whatever its LOD.
+*/
+
+// Scales a field's strength by distance from its center, as a fraction t of its radius
+enum class ForceFalloff : Uint32 {
+	Constant = 0,	// 1
+	Linear,			// 1 - t
+	Quadratic,		// (1 - t)^2
+	Smooth			// 1 - smoothstep(t)
+};
+
+struct ForceField
 {
-	// Adds force to rb->motion_props->accumulated_force
-	virtual void operator()(RigidBody* rb, Float32 dt) const noexcept = 0;
+	enum class Type : Uint32 {
+		Radial = 0,		// along center --> body. Negative strength pulls in (magnets)
+		Directional,	// along direction (wind, conveyors)
+		Vortex			// around the direction axis, counter-clockwise for positive strength
+	};
+
+	enum class Mode : Uint32 {
+		Force = 0,		// added to accumulated_force every step while the field lives
+		Impulse			// added to linear_velocity once (explosions), then the field is removed
+	};
+
+	static constexpr Float32 PERSISTENT = -1.0f;
+	static constexpr Uint32  ALL_LAYERS = ~0u;
+
+	Type		 type = Type::Radial;
+	Mode		 mode = Mode::Force;
+	ForceFalloff falloff = ForceFalloff::Linear;
+
+	Vec3		 center = Vec3(0);
+	Float32		 radius = 1.0f;
+	Vec3		 direction = Vec3(0, 1, 0);	// Directional: force direction. Vortex: axis. Normalized when added.
+	Float32		 strength = 0.0f;			// Newtons (Force) or Newton-seconds (Impulse)
+
+	Float32		 duration = PERSISTENT;		// Seconds left before the field is removed, or PERSISTENT
+	Bool		 scale_by_mass = false;		// If true, strength is an acceleration and affects all masses equally
+	Uint32		 layer_mask = ALL_LAYERS;	// Bodies whose RigidBody::layer bit is not set are not affected
 };
 
-struct ForceRegistration
+// Identifies a field in the ForceFieldRegistry. 0 is never a valid ID.
+using ForceFieldID = Uint32;
+
+class ForceFieldRegistry
 {
-	RigidBody* rb;
-	ForceGenerator* fg;
-};
\ No newline at end of file
+	struct Entry {
+		ForceFieldID id;
+		ForceField	 field;
+	};
+
+	Vector<Entry>	   fields;
+	ForceFieldID	   next_id = 1;
+
+	// Scratch storage reused by every field's query and force accumulation
+	Vector<RigidBody*> overlaps;
+	Vector<Float32>	   lanes;
+
+public:
+	ForceFieldID Add(ForceField const& field);
+
+	// Convenience for a one-shot radial impulse
+	ForceFieldID AddExplosion(Vec3 const& center, Float32 radius, Float32 impulse, ForceFalloff falloff = ForceFalloff::Linear);
+
+	// Returns false if the field was already removed (e.g. it expired)
+	Bool Remove(ForceFieldID id);
+
+	// Returns nullptr if the field was removed. Used to move fields along with
+	// their source, e.g. a magnet attached to a player.
+	ForceField* Find(ForceFieldID id);
+
+	void Clear();
+
+	// Applies every field to the overlapping bodies in bvh, then ages fields by
+	// time_step and removes the expired ones. Returns the number of body-field
+	// interactions.
+	Uint32 Apply(Collision::BVHierarchy const& bvh, Float32 time_step);
+
+	inline Uint32 Size() const noexcept { return static_cast<Uint32>(fields.size()); }
+
+private:
+	void Accumulate(ForceField const& field);
+};
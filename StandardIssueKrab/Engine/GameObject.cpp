@@ -5,6 +5,7 @@
 #include "FrameRateManager.h"
 #include "ScriptingManager.h"
 #include "MemoryManager.h"
+#include "GameObjectManager.h"
 
 //TODO: Figure out an efficient way of generating uuids in runtime
 
@@ -14,8 +15,25 @@
 * passes it's own allocator.
 */
 GameObject::GameObject(const char* _name, PolymorphicAllocator obj_alloc) :
-	name(_name, obj_alloc), is_active(true), transform(), rigidbody(nullptr),
-	game_components(obj_alloc) {
+	name(_name, obj_alloc), name_sid(ToStringID(_name)), tags(obj_alloc),
+	is_active(true), transform(), rigidbody(nullptr), game_components(obj_alloc) {
+}
+
+/*
+* Destroys a game-side component. Components made by the Factory go back to
+* their column of the component storage. Any other one comes from the same
+* allocator as its object, and is returned to it with the size of its own type
+* rather than sizeof(Component).
+*/
+static void DestroyComponent(Component* p_comp, PolymorphicAllocator alloc) {
+	if (p_game_obj_manager != nullptr && p_game_obj_manager->GetComponentStorage().Destroy(p_comp)) {
+		return;
+	}
+
+	SizeT const size = p_comp->GetSize();
+	SizeT const alignment = p_comp->GetAlignment();
+	std::destroy_at(p_comp);
+	alloc.deallocate_bytes(p_comp, size, alignment);
 }
 
 GameObject::~GameObject()
@@ -38,13 +56,46 @@ GameObject::~GameObject()
 	}
 
 	//Delete the Components created by the builder
-	//For some reason the UniquePointers don't call the pmr delete_object
-	//so that reports a leak whenever we have components.
 	for (auto& component : game_components) {
-		MemoryManager::GetDefaultAllocator().delete_object(
-			component.release()
-		);
+		DestroyComponent(component.release(), game_components.get_allocator());
+	}
+}
+
+void GameObject::SetName(const char* _name) {
+	Bool const indexed = not handle.IsNull();
+	if (indexed) { p_game_obj_manager->UnindexName(this); }
+
+	name = _name;
+	name_sid = ToStringID(_name);
+
+	if (indexed) { p_game_obj_manager->IndexName(this); }
+}
+
+void GameObject::SetParent(GameObject* _parent) {
+#ifdef _DEBUG
+	for (GameObject* p = _parent; p != nullptr; p = p_game_obj_manager->Resolve(p->parent)) {
+		SIK_ASSERT(p != this, "An object cannot be its own ancestor.");
 	}
+#endif
+	SIK_ASSERT(_parent == nullptr || _parent->handle, "Parents must be made by the GameObjectManager.");
+
+	parent = _parent ? _parent->handle : GameObjectHandle{};
+	world_transform.valid = false;
+}
+
+void GameObject::AddTag(StringID tag) {
+	if (HasTag(tag)) { return; }
+
+	tags.push_back(tag);
+	if (not handle.IsNull()) { p_game_obj_manager->IndexTag(this, tag); }
+}
+
+void GameObject::RemoveTag(StringID tag) {
+	auto it = std::find(tags.begin(), tags.end(), tag);
+	if (it == tags.end()) { return; }
+
+	tags.erase(it);
+	if (not handle.IsNull()) { p_game_obj_manager->UnindexTag(this, tag); }
 }
 
 void GameObject::Enable() {
@@ -115,33 +166,12 @@ void GameObject::OnCollide(GameObject* other) {
 		bh->SetCollided();
 	}
 
-	for (auto&& comp : game_components) {
-		comp->OnCollide(other);
+	for (Uint8 i = 0; i < on_collide_list.count; ++i) {
+		game_components[on_collide_list.slots[i]]->OnCollide(other);
 	}
 }
 
 
-Component* GameObject::HasComponent(Component::Type comp_type) {
-#if COMPONENT_LINEAR_ACCESS
-	auto it = std::find_if(
-		game_components.begin(),
-		game_components.end(),
-		[&comp_type](UniquePtr<Component> const& comp) {
-			return comp->GetType() == comp_type;
-		});
-
-	if (it != game_components.end()) {
-		return it->get();
-	}
-
-	return nullptr;
-
-#else
-	return game_components[static_cast<SizeT>(comp_type)].get();
-
-#endif
-}
-
 /*
 * Converts the name into StringID for checking against the map
 * Returns: Pointer to the component or nullptr of Component doesn't exist
@@ -162,12 +192,57 @@ Component* GameObject::HasComponent(StringID component_name_sid) {
 * **Only use when removing components added from the prototypes**
 */
 Component* GameObject::RemoveLastComponent() {
-#if COMPONENT_LINEAR_ACCESS
-	auto it = game_components.rbegin();
-	return it->release();
-#else
+	if (game_components.empty()) {
+		return nullptr;
+	}
+
+	Component* component = game_components.back().release();
 	game_components.pop_back();
-#endif
+	component_mask.reset(static_cast<SizeT>(component->GetType()));
+	RebuildPhaseLists();
+	return component;
+}
+
+/*
+* Removes the component of the given type, keeping the order of the others.
+* Returns the component, which the caller now owns, or nullptr if there was none.
+*/
+Component* GameObject::RemoveComponent(Component::Type comp_type) {
+	Component* component = HasComponent(comp_type);
+	if (component == nullptr) {
+		return nullptr;
+	}
+
+	SizeT const slot = component_slots[static_cast<SizeT>(comp_type)];
+	game_components[slot].release();
+	game_components.erase(game_components.begin() + slot);
+	component_mask.reset(static_cast<SizeT>(comp_type));
+
+	// Components after it moved down one slot
+	for (SizeT i = slot; i < game_components.size(); ++i) {
+		component_slots[static_cast<SizeT>(game_components[i]->GetType())] = static_cast<Uint8>(i);
+	}
+	RebuildPhaseLists();
+	return component;
+}
+
+void GameObject::RebuildPhaseLists() {
+	update_list.count = 0;
+	fixed_update_list.count = 0;
+	on_collide_list.count = 0;
+
+	for (SizeT slot = 0; slot < game_components.size(); ++slot) {
+		Uint8 const phases = game_components[slot]->GetPhases();
+		if (phases & Component::PHASE_UPDATE) {
+			update_list.slots[update_list.count++] = static_cast<Uint8>(slot);
+		}
+		if (phases & Component::PHASE_FIXED_UPDATE) {
+			fixed_update_list.slots[fixed_update_list.count++] = static_cast<Uint8>(slot);
+		}
+		if (phases & Component::PHASE_ON_COLLIDE) {
+			on_collide_list.slots[on_collide_list.count++] = static_cast<Uint8>(slot);
+		}
+	}
 }
 
 /*
@@ -195,23 +270,21 @@ void GameObject::Reset() {
 void GameObject::AddComponent(Component* component) {
 	component->SetOwner(this);
 
-#if COMPONENT_LINEAR_ACCESS
-	auto comp_type = component->GetType();
-	for (auto&& c : game_components) {
-		if (c->GetType() == comp_type) {
-			c.reset(component);
-			return;
-		}
-	}
-	game_components.emplace_back(component);
+	SizeT const type = static_cast<SizeT>(component->GetType());
+	SIK_ASSERT(type < Component::NUM_COMPONENTS, "Component has an invalid type.");
 
-#else
-	SizeT index = static_cast<SizeT>(component->GetType());
-	if (game_components.size() < index + 1) {
-		game_components.resize(index + 1);
+	if (component_mask.test(type)) {
+		UniquePtr<Component>& existing = game_components[component_slots[type]];
+		DestroyComponent(existing.release(), game_components.get_allocator());
+		existing.reset(component);
+		RebuildPhaseLists();
+		return;
 	}
-	game_components[index].reset(component);
-#endif
+
+	component_slots[type] = static_cast<Uint8>(game_components.size());
+	component_mask.set(type);
+	game_components.emplace_back(component);
+	RebuildPhaseLists();
 }
 
 void GameObject::AddComponent(RigidBody* rb) {
@@ -249,21 +322,16 @@ void GameObject::Update(Float32 dt) {
 
 	if (behaviour != nullptr) { behaviour->Update(dt); }
 
-#if COMPONENT_LINEAR_ACCESS
-		std::for_each(
-			game_components.begin(), 
-			game_components.end(), 
-			[dt](UniquePtr<Component> const& ptr) {
-				ptr->Update(dt);
-			});
-#else
-		std::for_each(
-			game_components.begin(),
-			game_components.end(),
-			[dt](UniquePtr<Component> const& ptr) {
-				if (ptr != nullptr) { ptr->Update(dt); }
-			});
-#endif
+	TickScheduler const& scheduler = p_game_obj_manager->GetTickScheduler();
+
+	// Indexed, since a component may add another one to this object
+	for (Uint8 i = 0; i < update_list.count; ++i) {
+		Component* comp = game_components[update_list.slots[i]].get();
+		Float32 tick_dt = dt;
+		if (scheduler.ShouldUpdate(*comp, tick_dt)) {
+			comp->Update(tick_dt);
+		}
+	}
 }
 
 void GameObject::FixedUpdate(Float32 fixed_dt) {
@@ -272,21 +340,15 @@ void GameObject::FixedUpdate(Float32 fixed_dt) {
 
 	//if (behaviour != nullptr) { behaviour->FixedUpdate(fixed_dt); }
 
-#if COMPONENT_LINEAR_ACCESS
-		std::for_each(
-			game_components.begin(), 
-			game_components.end(), 
-			[fixed_dt](UniquePtr<Component> const& ptr) {
-				ptr->FixedUpdate(fixed_dt);
-			});
-#else
-		std::for_each(
-			game_components.begin(),
-			game_components.end(),
-			[dt](UniquePtr<Component> const& ptr) {
-				if (ptr != nullptr) { ptr->FixedUpdate(fixed_dt); }
-			});
-#endif
+	TickScheduler const& scheduler = p_game_obj_manager->GetTickScheduler();
+
+	for (Uint8 i = 0; i < fixed_update_list.count; ++i) {
+		Component* comp = game_components[fixed_update_list.slots[i]].get();
+		Float32 tick_dt = fixed_dt;
+		if (scheduler.ShouldFixedUpdate(*comp, tick_dt)) {
+			comp->FixedUpdate(tick_dt);
+		}
+	}
 }
 
 
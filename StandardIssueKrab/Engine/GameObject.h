@@ -4,33 +4,34 @@
 #include "RigidBody.h"
 #include "MeshRenderer.h"
 #include "Behaviour.h"
-
-/*
-* Set this at compile-time to tune how components are accessed and stored. 
-* If defined as 1: components will be stored in a dense vector and accessed 
-* linearly.
-* If defined as 0: components will be stored in a sparse vector and accessed by
-* index.
-* Here we make the default Linear Access
-*/
-#ifndef COMPONENT_LINEAR_ACCESS
-#define COMPONENT_LINEAR_ACCESS 1
-#endif
-
+#include "Handle.h"
 
 /*
 * A GameObject class.
 * Essentially just a list of components.
 * The GameObject itself does NOT define any behavior.
 * All behavior needs to be contained in components.
+*
+* Game-side components are kept in a dense vector, in the order they were added.
+* A bitmask of the types present and a table from type to slot in that vector
+* make HasComponent a bit test and an indexed load. Update, FixedUpdate and
+* OnCollide only call the components whose type overrides that callback.
 */
+class GameObject;
+using GameObjectHandle = Handle<GameObject>;
+
 class GameObject {
 public:
 	friend class PhysicsManager;
 	friend class ScriptingManager;
+	friend class GameObjectManager;
+	friend class GraphicsManager;
 private:
 	bool is_active;
+	GameObjectHandle handle; // set by GameObjectManager
 	Transform transform;
+	GameObjectHandle parent; // transform is relative to this object's, if set
+	WorldTransform world_transform;
 
 	RigidBody* rigidbody;
 	MeshRenderer* mesh_renderer;
@@ -39,7 +40,24 @@ private:
 	// ...
 
 	Vector<UniquePtr<Component>> game_components; // game-specific components
+	Bitset<Component::NUM_COMPONENTS> component_mask; // types in game_components
+	Array<Uint8, Component::NUM_COMPONENTS> component_slots{}; // index in game_components, if the type's bit is set
+	static_assert(Component::NUM_COMPONENTS <= 256, "Component slots are stored as Uint8.");
+
+	// Slots of the components which override a phase's callback, so the empty
+	// base Update/FixedUpdate/OnCollide are never called
+	struct PhaseList {
+		Array<Uint8, Component::NUM_COMPONENTS> slots{};
+		Uint8 count = 0;
+	};
+	PhaseList update_list;
+	PhaseList fixed_update_list;
+	PhaseList on_collide_list;
+
 	String name;
+	StringID name_sid;		// key of this object in the GameObjectManager's name index
+	StringID archetype{};	// file it was built from by the Factory, if any
+	Vector<StringID> tags;
 public:
 	//Creates a named game object
 	explicit GameObject(const char* _name = "<NO NAME>", PolymorphicAllocator _obj_alloc = {});
@@ -60,16 +78,49 @@ public:
 	//Enable game object
 	void Enable();
 
-	//Sets the name of the game object
-	inline void SetName(const char* _name);
+	//Sets the name of the game object, and updates the GameObjectManager's
+	//name index if it made this object
+	void SetName(const char* _name);
 
 	//Returns the name of the Game object
 	inline const String& GetName() const;
+	inline StringID GetNameSID() const;
+
+	//Archetype file the Factory built this object from, or StringID{}
+	inline StringID GetArchetype() const;
+
+	//Tags group objects for GameObjectManager::ForEachWithTag. Adding a tag
+	//twice, or removing one the object doesn't have, does nothing.
+	void AddTag(StringID tag);
+	void RemoveTag(StringID tag);
+	inline Bool HasTag(StringID tag) const;
+	inline const Vector<StringID>& GetTags() const;
+
+	//Returns the handle to hold instead of a pointer to this object. Resolve it
+	//with GameObjectManager::Resolve. Null if not made by the GameObjectManager.
+	inline GameObjectHandle GetHandle() const;
 
-	//Gets a reference to the internal vector of component ptrs
-	inline Vector<UniquePtr<Component>>& GetComponentArray();
+	//World matrix, including the parents' transforms, as of the last
+	//GameObjectManager::UpdateWorldMatrices. Identity before the first one.
+	inline const Mat4& GetWorldMat4() const;
+
+	//Makes this object's transform relative to parent's, or to the world if
+	//parent is nullptr. Objects with a dynamic RigidBody should not have a
+	//parent, since physics writes their transform in world space.
+	//Only the world matrix accounts for the parent: gameplay code and scripts
+	//reading a parented object's Transform get its pose relative to the
+	//parent, and should use GetWorldMat4 for the world one. When the parent
+	//is deleted, its last world matrix is folded into the transform.
+	void SetParent(GameObject* _parent);
+	inline GameObjectHandle GetParent() const;
+
+	//Gets a reference to the internal vector of component ptrs.
+	//Use AddComponent/RemoveComponent to change it.
 	inline const Vector<UniquePtr<Component>>& GetComponentArray() const;
 
+	//Types of the game-side components this object has
+	inline Bitset<Component::NUM_COMPONENTS> const& GetComponentMask() const;
+
 	//Checks if the game object has a particular component. Returns it if present.
 	//Prefer to use this method over the other HasComponent overloads since this
 	//one will give a compile-time error if you attempt to access an invalid
@@ -81,7 +132,10 @@ public:
 	template<> inline MeshRenderer* HasComponent<MeshRenderer>();
 	template<> inline Behaviour* HasComponent<Behaviour>();
 
-	//Adds a component to the list of components of the game object.
+	//Adds a component to the list of components of the game object, replacing
+	//(and destroying) one of the same type. Game-side components should come
+	//from the GameObjectManager's component storage, as the Factory's do, so
+	//the manager updates them with the rest of their type.
 	void AddComponent(Component* component);
 	void AddComponent(RigidBody* rb);
 	void AddComponent(MeshRenderer* mr);
@@ -99,7 +153,7 @@ public:
 	///////////////////////////////////////
 	
 	// Note that these will NOT work with engine-side components (e.g. RigidBody, Behaviour)
-	Component* HasComponent(Component::Type comp_type);
+	inline Component* HasComponent(Component::Type comp_type);
 	Component* HasComponent(const char* component_name);
 	Component* HasComponent(StringID component_name_sid);
 
@@ -109,6 +163,12 @@ public:
 	*/
 	Component* RemoveLastComponent();
 
+	/*
+	* Removes the component of the given type without destroying it.
+	* Returns: the component, now owned by the caller, or nullptr
+	*/
+	Component* RemoveComponent(Component::Type comp_type);
+
 	/*
 	* Links the related components.
 	* Must be called after all the components have been added to the game object
@@ -126,6 +186,10 @@ public:
 	* Returns: void
 	*/
 	void Reset();
+
+private:
+	// Called whenever game_components changes
+	void RebuildPhaseLists();
 };
 
 // Inline definitions
@@ -133,21 +197,55 @@ inline bool GameObject::IsActive() const {
 	return is_active;
 }
 
-inline void GameObject::SetName(const char* _name) {
-	name = _name;
-}
-
 inline const String& GameObject::GetName() const {
 	return name;
 }
 
-inline Vector<UniquePtr<Component>>& GameObject::GetComponentArray() {
-	return game_components;
+inline StringID GameObject::GetNameSID() const {
+	return name_sid;
+}
+
+inline StringID GameObject::GetArchetype() const {
+	return archetype;
+}
+
+inline Bool GameObject::HasTag(StringID tag) const {
+	return std::find(tags.begin(), tags.end(), tag) != tags.end();
+}
+
+inline const Vector<StringID>& GameObject::GetTags() const {
+	return tags;
+}
+
+inline GameObjectHandle GameObject::GetHandle() const {
+	return handle;
 }
+
+inline const Mat4& GameObject::GetWorldMat4() const {
+	return world_transform.world;
+}
+
+inline GameObjectHandle GameObject::GetParent() const {
+	return parent;
+}
+
 inline const Vector<UniquePtr<Component>>& GameObject::GetComponentArray() const {
 	return game_components;
 }
 
+inline Bitset<Component::NUM_COMPONENTS> const& GameObject::GetComponentMask() const {
+	return component_mask;
+}
+
+// Also called with Component::Type::INVALID by the name overloads
+inline Component* GameObject::HasComponent(Component::Type comp_type) {
+	SizeT const type = static_cast<SizeT>(comp_type);
+	if (type >= Component::NUM_COMPONENTS || not component_mask[type]) {
+		return nullptr;
+	}
+	return game_components[component_slots[type]].get();
+}
+
 template<ValidComponent C>
 C* GameObject::HasComponent() {
 	return static_cast<C*>( HasComponent(C::type) );
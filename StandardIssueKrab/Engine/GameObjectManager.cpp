@@ -2,33 +2,132 @@
 #include "MemoryResources.h"
 #include "GameObjectManager.h"
 
+#include "MemoryManager.h"
+#include "RigidBody.h"
+#include "MotionProperties.h"
+
+// Stops a body and places it, as if it had just been built there
+static void PlaceBody(RigidBody& rb, Vec3 const& position, Quat const& orientation) {
+	rb.position = position;
+	rb.orientation = orientation;
+	if (rb.motion_props) {
+		MotionProperties& mp = *rb.motion_props;
+		mp.prev_position = position;
+		mp.prev_orientation = orientation;
+		mp.linear_velocity = Vec3(0);
+		mp.angular_velocity = Vec3(0);
+		mp.accumulated_force = Vec3(0);
+		mp.accumulated_torque = Vec3(0);
+	}
+	rb.UpdateAABB();
+}
+
+// Removes obj's entry under key, if it has one
+static void EraseEntry(UnorderedMultiMap<StringID, GameObject*>& index, StringID key, GameObject* obj) {
+	auto [first, last] = index.equal_range(key);
+	auto it = std::find_if(first, last, [obj](auto const& entry) { return entry.second == obj; });
+	if (it != last) {
+		index.erase(it);
+	}
+}
+
 /*
 * Create a game object using the given name and stores it
 * in the list of game objects.
 * Returns: pointer to GameObject
 */
 GameObject* GameObjectManager::CreateGameObject(const char* obj_name) {
-	return game_object_pool.emplace(obj_name);
+	GameObject* obj = game_object_pool.emplace(obj_name, p_memory_manager->GetSceneAllocator());
+	obj->handle = handles.Create(obj);
+	IndexName(obj);
+	return obj;
 }
 
 /*
-* Calls the Update() function for each game object
+* Updates the Behaviour of each active game object, then runs
+* every type's components through the component storage
 * Returns: void
 */
 void GameObjectManager::Update(Float32 dt) {
 	for (auto r = game_object_pool.all(); not r.is_empty(); r.pop_front()) {
-		r.front().Update(dt);
+		GameObject& obj = r.front();
+		if (obj.IsActive() && obj.behaviour != nullptr) {
+			obj.behaviour->Update(dt);
+		}
 	}
+	components.Update(dt, tick_scheduler);
 }
 
-/*
-* Calls the Update() function for each game object
-* Returns: void
-*/
-void GameObjectManager::FixedUpdate(Float32 fixed_dt) {
+void GameObjectManager::Update(Vector<GameObject*> const& objects, Float32 dt) {
+	for (GameObject* obj : objects) {
+		if (obj->IsActive() && obj->behaviour != nullptr) {
+			obj->behaviour->Update(dt);
+		}
+	}
+	components.Update(objects, dt, tick_scheduler);
+}
+
+void GameObjectManager::FixedUpdate(Vector<GameObject*> const& objects, Float32 fixed_dt) {
+	components.FixedUpdate(objects, fixed_dt, tick_scheduler);
+}
+
+void GameObjectManager::UpdateWorldMatrices() {
+	++world_frame;
+
+	// Local matrices of the transforms written since the last update
+	dirty_objects.clear();
 	for (auto r = game_object_pool.all(); not r.is_empty(); r.pop_front()) {
-		r.front().FixedUpdate(fixed_dt);
+		GameObject& obj = r.front();
+		WorldTransform const& wt = obj.world_transform;
+		if (not wt.valid || wt.composed_from != obj.transform) {
+			dirty_objects.push_back(&obj);
+		}
 	}
+
+	Uint32 const dirty_count = static_cast<Uint32>(dirty_objects.size());
+	transform_batch.Resize(dirty_count);
+	for (Uint32 i = 0; i < dirty_count; ++i) {
+		transform_batch.LoadTransform(i, dirty_objects[i]->transform);
+	}
+	transform_batch.Compose();
+	for (Uint32 i = 0; i < dirty_count; ++i) {
+		WorldTransform& wt = dirty_objects[i]->world_transform;
+		transform_batch.StoreMatrix(i, wt.local);
+		wt.composed_from = dirty_objects[i]->transform;
+		wt.valid = false; // the world matrix is stale until UpdateWorldMatrix
+	}
+
+	// World matrices, parents first
+	for (auto r = game_object_pool.all(); not r.is_empty(); r.pop_front()) {
+		UpdateWorldMatrix(r.front());
+	}
+}
+
+Bool GameObjectManager::UpdateWorldMatrix(GameObject& obj) {
+	WorldTransform& wt = obj.world_transform;
+	if (wt.frame == world_frame) { return wt.changed; }
+
+	GameObject* parent = handles.Resolve(obj.parent);
+	if (parent == nullptr && obj.parent) {
+		// The parent was deleted. Its last world matrix is folded into the
+		// transform, which leaves this object where it was, in world space.
+		obj.parent = GameObjectHandle{};
+		wt.local = wt.parent_world * wt.local;
+		obj.transform = Transform::FromMat4(wt.local);
+		wt.composed_from = obj.transform;
+		wt.parent_world = Mat4(1);
+		wt.valid = false;
+	}
+	Bool const parent_changed = parent != nullptr && UpdateWorldMatrix(*parent);
+
+	wt.changed = not wt.valid || parent_changed;
+	if (wt.changed) {
+		wt.parent_world = parent ? parent->world_transform.world : Mat4(1);
+		wt.world = wt.parent_world * wt.local;
+		wt.valid = true;
+	}
+	wt.frame = world_frame;
+	return wt.changed;
 }
 
 /*
@@ -38,11 +137,35 @@ void GameObjectManager::FixedUpdate(Float32 fixed_dt) {
 */
 void GameObjectManager::DeleteAllGameObjects() {
 	objects_to_delete.clear();
+	handles.Clear();
+	for (auto& [archetype, pool] : recycle_pools) {
+		pool.objects.clear(); // the limits and spawn poses still apply
+	}
+	name_index.clear();
+	tag_index.clear();
 	game_object_pool.clear();
+
+	// Every name, component list and component is gone with the objects
+	components.Clear();
+	p_memory_manager->ReleaseSceneResource();
 }
 
 Bool GameObjectManager::DeleteGameObject(GameObject* _p_delete_obj) {
+	if (not handles.IsValid(_p_delete_obj->handle)) { return false; }
+
+	auto pool_it = recycle_pools.find(_p_delete_obj->archetype);
+	if (pool_it != recycle_pools.end() && pool_it->second.objects.size() < pool_it->second.max_size) {
+		_p_delete_obj->Disable();
+		_p_delete_obj->is_active = false;
+		_p_delete_obj->Reset();
+		_p_delete_obj->parent = GameObjectHandle{};
+		handles.Release(_p_delete_obj->handle);
+		pool_it->second.objects.push_back(_p_delete_obj);
+		return true;
+	}
+
 	_p_delete_obj->Disable();
+	handles.Release(_p_delete_obj->handle);
 	objects_to_delete.push_back(_p_delete_obj);
 	return true;
 }
@@ -51,8 +174,109 @@ Bool GameObjectManager::DeleteGameObject(GameObject* _p_delete_obj) {
 * Called once per frame at the end
 */
 void GameObjectManager::CleanupDeletedObjects() {
+	// Commands deferred outside a component sweep, e.g. by the game states'
+	// per-object updates, may still delete objects
+	components.RunDeferred();
+
+	Bool const deleted_any = not objects_to_delete.empty();
 	for (auto obj : objects_to_delete) {
+		UnindexName(obj);
+		for (StringID tag : obj->GetTags()) {
+			UnindexTag(obj, tag);
+		}
 		game_object_pool.erase(obj);
 	}
 	objects_to_delete.clear();
+
+	// Nothing is iterating the pool at the end of the frame
+	game_object_pool.trim();
+	components.Trim();
+
+	// The last object of the scene is gone, so is all of its memory
+	if (deleted_any && game_object_pool.empty()) {
+		components.Clear();
+		p_memory_manager->ReleaseSceneResource();
+	}
+}
+
+void GameObjectManager::SetRecycleLimit(StringID archetype, Uint32 max_size) {
+	RecyclePool& pool = recycle_pools[archetype];
+	pool.max_size = max_size;
+
+	// Pooled objects' handles are already released
+	while (pool.objects.size() > max_size) {
+		objects_to_delete.push_back(pool.objects.back());
+		pool.objects.pop_back();
+	}
+}
+
+GameObject* GameObjectManager::TakeRecycled(StringID archetype) {
+	auto pool_it = recycle_pools.find(archetype);
+	if (pool_it == recycle_pools.end() || pool_it->second.objects.empty()) { return nullptr; }
+
+	RecyclePool& pool = pool_it->second;
+	GameObject* obj = pool.objects.back();
+	pool.objects.pop_back();
+
+	obj->handle = handles.Create(obj);
+	if (pool.has_spawn_state) {
+		obj->transform = pool.spawn_transform;
+	}
+	if (obj->rigidbody) {
+		// Stops the body even without a spawn pose, where it is left in place
+		RigidBody& rb = *obj->rigidbody;
+		PlaceBody(rb,
+			pool.has_spawn_state ? pool.spawn_body_position : rb.position,
+			pool.has_spawn_state ? pool.spawn_body_orientation : rb.orientation);
+	}
+	obj->world_transform.valid = false;
+	obj->Enable();
+	return obj;
+}
+
+void GameObjectManager::SetArchetype(GameObject* obj, StringID archetype) {
+	obj->archetype = archetype;
+
+	// Recorded from the first object built, even before the archetype gets a
+	// recycle limit, since any object carrying the archetype can be pooled
+	RecyclePool& pool = recycle_pools[archetype];
+	if (not pool.has_spawn_state) {
+		pool.spawn_transform = obj->transform;
+		if (obj->rigidbody) {
+			pool.spawn_body_position = obj->rigidbody->position;
+			pool.spawn_body_orientation = obj->rigidbody->orientation;
+		}
+		pool.has_spawn_state = true;
+	}
+}
+
+SizeT GameObjectManager::RecycledCount(StringID archetype) const {
+	auto pool_it = recycle_pools.find(archetype);
+	return pool_it != recycle_pools.end() ? pool_it->second.objects.size() : 0;
+}
+
+GameObject* GameObjectManager::FindByName(StringID name) const {
+	auto [first, last] = name_index.equal_range(name);
+	for (; first != last; ++first) {
+		if (handles.IsValid(first->second->GetHandle())) {
+			return first->second;
+		}
+	}
+	return nullptr;
+}
+
+void GameObjectManager::IndexName(GameObject* obj) {
+	name_index.emplace(obj->GetNameSID(), obj);
+}
+
+void GameObjectManager::UnindexName(GameObject* obj) {
+	EraseEntry(name_index, obj->GetNameSID(), obj);
+}
+
+void GameObjectManager::IndexTag(GameObject* obj, StringID tag) {
+	tag_index.emplace(tag, obj);
+}
+
+void GameObjectManager::UnindexTag(GameObject* obj, StringID tag) {
+	EraseEntry(tag_index, tag, obj);
 }
@@ -1,16 +1,47 @@
 #pragma once
 
-#include "FixedObjectPool.h"
+#include "ChunkedObjectPool.h"
+#include "ComponentStorage.h"
 #include "GameObject.h"
+#include "TransformBatch.h"
 
 class GameObjectManager {
-	static constexpr SizeT MAX_GAME_OBJECTS = 8192;
-	template<class T> using Pool = FixedObjectPool<T, MAX_GAME_OBJECTS>;
+	static constexpr SizeT POOL_CHUNK_SIZE = 256;
+	template<class T> using Pool = ChunkedObjectPool<T, POOL_CHUNK_SIZE>;
+	using Index = UnorderedMultiMap<StringID, GameObject*>;
+
+	friend class GameObject; // keeps the indexes up to date
 
 private:
+	ComponentStorage components; // declared first so it outlives the objects using it
+	TickScheduler tick_scheduler;
 	Pool<GameObject> game_object_pool;
+	HandleTable<GameObject> handles;
 	Vector<GameObject*> objects_to_delete;
 
+	// Objects by name and by tag. Deleted objects stay in them until the end
+	// of the frame, but are skipped by the lookups since their handle is stale.
+	Index name_index;
+	Index tag_index;
+
+	// Deleted objects kept for reuse, by archetype
+	struct RecyclePool {
+		Vector<GameObject*> objects;
+		Uint32 max_size = 0;
+
+		// Pose of a freshly built object, restored when one is reused
+		Transform spawn_transform;
+		Vec3 spawn_body_position = Vec3(0);
+		Quat spawn_body_orientation = Quat(1, 0, 0, 0);
+		Bool has_spawn_state = false;
+	};
+	UnorderedMap<StringID, RecyclePool> recycle_pools;
+
+	// Scratch for UpdateWorldMatrices, kept for its capacity
+	TransformBatch transform_batch;
+	Vector<GameObject*> dirty_objects;
+	Uint32 world_frame = 0;
+
 public:
 	// Defaulted ctors and dtor
 
@@ -21,16 +52,34 @@ public:
 	GameObject* CreateGameObject(const char* obj_name = "<NO NAME>");
 
 	/*
-	* Calls the Update() function for each game object
+	* Updates every active game object: first each Behaviour, then the game-side
+	* components from the component storage, in parallel where their types'
+	* declared access allows it
 	* Returns: void
 	*/
 	void Update(Float32 dt);
 
 	/*
-	* Calls the FixedUpdate() function for each game object
+	* Same as Update, over the active objects in objects only, e.g. those a
+	* game state holds
+	* Returns: void
+	*/
+	void Update(Vector<GameObject*> const& objects, Float32 dt);
+
+	/*
+	* Calls FixedUpdate() on the components of the active objects in objects,
+	* one type at a time, in parallel where their access allows it
+	* Returns: void
+	*/
+	void FixedUpdate(Vector<GameObject*> const& objects, Float32 fixed_dt);
+
+	/*
+	* Recomposes the local matrix of every object whose transform changed, in
+	* one SIMD batch, then the world matrix of those and of their children.
+	* Called once per frame after physics and gameplay, before rendering.
 	* Returns: void
 	*/
-	void FixedUpdate(Float32 fixed_dt);
+	void UpdateWorldMatrices();
 
 	/*
 	* Clears the container holding all game objects
@@ -39,11 +88,40 @@ public:
 	void DeleteAllGameObjects();
 
 	/*
-	* Deletes a specific game object
-	* Returns: Bool - True if success
+	* Deletes a specific game object. If its archetype has a recycle pool with
+	* room, the object is disabled, Reset() and kept in the pool instead. Either
+	* way its handle is invalidated right away.
+	* Returns: Bool - True if success, false if it was already deleted
 	*/
 	Bool DeleteGameObject(GameObject* _p_delete_obj);
 
+	/*
+	* Keeps up to max_size deleted objects of the archetype for the Factory to
+	* hand back instead of building new ones. 0 stops recycling it. Pooled
+	* objects over the new limit are deleted.
+	* See Factory::WarmRecyclePool.
+	*/
+	void SetRecycleLimit(StringID archetype, Uint32 max_size);
+
+	/*
+	* Takes a deleted object of the archetype from its recycle pool, enabled,
+	* with a new handle and in the pose the archetype is built in.
+	* Returns: the object, or nullptr if the pool is empty
+	*/
+	GameObject* TakeRecycled(StringID archetype);
+
+	/*
+	* Records that the Factory built obj from the archetype file, so deleting
+	* it can recycle it. The first object recorded gives the archetype's spawn
+	* pose, whether or not it has a recycle limit yet.
+	*/
+	void SetArchetype(GameObject* obj, StringID archetype);
+
+	/*
+	* Number of objects waiting in the archetype's recycle pool
+	*/
+	SizeT RecycledCount(StringID archetype) const;
+
 	/*
 	* Erases the game objects in the to_delete list
 	* Called once per frame at the end
@@ -56,11 +134,61 @@ public:
 	*/
 	template<class F> void ForEach(F fn);
 
+	/*
+	* Returns the game object a handle refers to, or nullptr if it was deleted.
+	* Deleting a game object invalidates its handle right away, though the
+	* object itself lives until the end of the frame.
+	*/
+	inline GameObject* Resolve(GameObjectHandle handle) const { return handles.Resolve(handle); }
+
+	/*
+	* Returns a game object with the given name, or nullptr if there is none
+	* or the name is null.
+	* If several objects share the name, returns any one of them.
+	* Runs in O(1), plus the number of objects with the name.
+	*/
+	GameObject* FindByName(StringID name) const;
+	inline GameObject* FindByName(const char* name) const { return name ? FindByName(ToStringID(name)) : nullptr; }
+
+	/*
+	* Calls fn on every game object with the given tag, in no particular order.
+	* fn may delete objects, but must not rename or retag any.
+	* Runs in O(1), plus the number of objects with the tag.
+	*/
+	template<class F> void ForEachWithTag(StringID tag, F fn);
+
+	/*
+	* Returns the storage game-side components are created in, e.g. to run a
+	* system over every component of one type
+	*/
+	inline ComponentStorage& GetComponentStorage() { return components; }
+
+	/*
+	* Returns the scheduler deciding how often each tick group of components
+	* updates. Its clocks are advanced by the main loop.
+	*/
+	inline TickScheduler& GetTickScheduler() { return tick_scheduler; }
+
+	/*
+	* Runs command on the main thread once the components updating in parallel
+	* are done. Use it for calls into other objects from a component's Update.
+	*/
+	inline void Defer(ComponentStorage::Command command) { components.Defer(std::move(command)); }
+
 	/*
 	* Returns underlying data structure holding all game objects
 	*/
 	inline Pool<GameObject>&		GetGameObjectContainer() { return game_object_pool; }
 	inline Pool<GameObject> const& GetGameObjectContainer() const { return game_object_pool; }
+
+private:
+	// Returns true if obj's world matrix changed this frame
+	Bool UpdateWorldMatrix(GameObject& obj);
+
+	void IndexName(GameObject* obj);
+	void UnindexName(GameObject* obj);
+	void IndexTag(GameObject* obj, StringID tag);
+	void UnindexTag(GameObject* obj, StringID tag);
 };
 
 //Extern global variable defined so it can be accessed throughout the project
@@ -73,4 +201,15 @@ void GameObjectManager::ForEach(F fn) {
 	for (auto r = game_object_pool.all(); not r.is_empty(); r.pop_front()) {
 		fn( r.front() );
 	}
+}
+
+template<class F>
+void GameObjectManager::ForEachWithTag(StringID tag, F fn) {
+	auto [first, last] = tag_index.equal_range(tag);
+	for (; first != last; ++first) {
+		GameObject* obj = first->second;
+		if (handles.IsValid(obj->GetHandle())) {
+			fn(*obj);
+		}
+	}
 }
\ No newline at end of file
@@ -51,16 +51,12 @@ void GameState::Update(Float32 dt) {
 	}
 	added_objects.clear();
 
-	// Update all objects
-	for (GameObject* object : objects_in_current_state) {
-		object->Update(dt);
-	}
+	// Update all objects, one component type at a time
+	p_game_obj_manager->Update(objects_in_current_state, dt);
 }
 
 void GameState::FixedUpdate(Float32 fixed_timestep) {
-	for (GameObject* object : objects_in_current_state) {
-		object->FixedUpdate(fixed_timestep);
-	}
+	p_game_obj_manager->FixedUpdate(objects_in_current_state, fixed_timestep);
 }
 
 void GameState::HandleEvent(SDL_Event const& e)
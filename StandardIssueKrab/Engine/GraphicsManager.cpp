@@ -228,11 +228,7 @@ void GraphicsManager::ShadowPass() {
             MeshRenderer& mr = m_rend.front();
             if (mr.owner == nullptr || !mr.is_valid || not mr.enabled) { continue; }
 
-            model_transform = Mat4(0);
-            Transform* tr = mr.owner->HasComponent<Transform>();
-            if (tr != nullptr) {
-                model_transform = tr->ToMat4();
-            }
+            model_transform = mr.owner->GetWorldMat4();
 
             SetUniform(*shadow_program, shadow_proj, "shadow_proj");
             SetUniform(*shadow_program, shadow_view, "shadow_view");
@@ -292,11 +288,7 @@ void GraphicsManager::LightingPass() {
             MeshRenderer& mr = m_rend.front();
             if (mr.owner == nullptr) { continue; }
 
-            model_transform = Mat4(0);
-            Transform* tr = mr.owner->HasComponent<Transform>();
-            if (tr != nullptr) {
-                model_transform = tr->ToMat4();
-            }
+            model_transform = mr.owner->GetWorldMat4();
 
             norm_inverse = glm::transpose(glm::inverse(model_transform));
 
@@ -381,11 +373,7 @@ void GraphicsManager::GBufferPass() {
                 continue;
             }
 
-            model_transform = Mat4(0);
-            Transform* tr = mr.owner->HasComponent<Transform>();
-            if (tr != nullptr) {
-                model_transform = tr->ToMat4();
-            }
+            model_transform = mr.owner->GetWorldMat4();
 
             norm_inverse = glm::transpose(glm::inverse(model_transform));
 
@@ -412,8 +400,7 @@ void GraphicsManager::GBufferPass() {
 
                 MeshRenderer& mr = *cube_renderers[i];
 
-                Transform* tr = mr.owner->HasComponent<Transform>();
-                model_transform = tr->ToMat4();
+                model_transform = mr.owner->GetWorldMat4();
                 norm_inverse = glm::transpose(glm::inverse(model_transform));
 
                 // Change material if we have to
@@ -1169,11 +1156,7 @@ void GraphicsManager::DrawNormals() {
         MeshRenderer& mr = m_rend.front();
         if (mr.owner == nullptr) { continue; }
 
-        model_transform = Mat4(0);
-        Transform* tr = mr.owner->HasComponent<Transform>();
-        if (tr != nullptr) {
-            model_transform = tr->ToMat4();
-        }
+        model_transform = mr.owner->GetWorldMat4();
 
         norm_inverse = glm::transpose(glm::inverse(model_transform));
 
@@ -1283,6 +1266,7 @@ void GraphicsManager::SetDepthTestOff() {
 
 //Teardown to clear the object pools
 void GraphicsManager::Clear() {
+    m_renderer_handles.Clear();
     m_renderers.clear();
 }
 
@@ -1317,7 +1301,9 @@ MeshRenderer* GraphicsManager::CreateMeshRenderer(Material* mat, Mesh* mesh) {
 	mr.mesh = mesh;
 	mr.is_valid = true;
 
-    return m_renderers.insert(mr);
+    MeshRenderer* p_mr = m_renderers.insert(mr);
+    p_mr->handle = m_renderer_handles.Create(p_mr);
+    return p_mr;
 }
 
 void GraphicsManager::DestroyMeshRenderer(MeshRenderer* mr) {
@@ -1336,9 +1322,24 @@ void GraphicsManager::CleanupDestroyedRenderers() {
 				mr.owner = nullptr;
 			}
 
+			m_renderer_handles.Release(mr.handle);
 			m_renderers.erase(&mr);
 		}
 	}
+
+	if (not compact_renderers) {
+		m_renderers.trim();
+		return;
+	}
+
+	SizeT const moved = m_renderers.compact([this](MeshRenderer*, MeshRenderer* to) {
+		m_renderer_handles.Relocate(to->handle, to);
+		if (to->owner != nullptr) {
+			to->owner->mesh_renderer = to;
+		}
+	});
+	compact_renderers = false;
+	SIK_INFO("Compacted MeshRenderers: moved {}, {} chunks left", moved, m_renderers.chunk_count());
 }
 
 void GraphicsManager::DrawSkyDome(bool deferred) {
@@ -13,7 +13,7 @@
 #include "Mesh.h"
 #include "Material.h"
 #include "MeshRenderer.h"
-#include "FixedObjectPool.h"
+#include "ChunkedObjectPool.h"
 #include "FBO.h"
 #include "MemoryResources.h"
 #include "Texture.h"
@@ -94,8 +94,10 @@ private:
 	Vector<DirectionalLight> m_lights;
 
 	// Mesh Renderers
-	static constexpr SizeT MAX_RENDER_OBJECTS = 8192;
-	FixedObjectPool<MeshRenderer, MAX_RENDER_OBJECTS> m_renderers;
+	static constexpr SizeT RENDER_POOL_CHUNK_SIZE = 256;
+	ChunkedObjectPool<MeshRenderer, RENDER_POOL_CHUNK_SIZE> m_renderers;
+	HandleTable<MeshRenderer> m_renderer_handles;
+	Bool compact_renderers = false;
 
 
 	// Shadow Map
@@ -131,8 +133,8 @@ private:
 	Vec3 color2;
 
 	// GUI Renderers
-	static constexpr SizeT MAX_GUI_RENDER_OBJECTS = 1024;
-	FixedObjectPool<GUIRenderer, MAX_GUI_RENDER_OBJECTS> gui_renderer_list;
+	static constexpr SizeT GUI_POOL_CHUNK_SIZE = 64;
+	ChunkedObjectPool<GUIRenderer, GUI_POOL_CHUNK_SIZE> gui_renderer_list;
 
 	// MSAA
 	UniquePtr<MSAA> msaa_fbo;
@@ -408,6 +410,22 @@ public:
 	void DestroyMeshRenderer(MeshRenderer* mr);
 	void CleanupDestroyedRenderers();
 
+	/*
+	* Returns the MeshRenderer a handle refers to, or nullptr once destroyed
+	*/
+	inline MeshRenderer* Resolve(MeshRendererHandle handle) const {
+		MeshRenderer* mr = m_renderer_handles.Resolve(handle);
+		return mr && mr->is_valid ? mr : nullptr;
+	}
+
+	/*
+	* Compacts the MeshRenderer pool during the next cleanup, moving renderers
+	* so drawing iterates them densely. Call after loading a level. Only
+	* handles and the owner's renderer survive the move, not raw pointers.
+	* Returns: void
+	*/
+	inline void RequestRendererCompaction() noexcept { compact_renderers = true; }
+
 	inline void ToggleDebugDrawing() noexcept;
 	static inline void EnableDebugDrawing() noexcept;
 	static inline Bool IsDebugDrawingEnabled() noexcept { return debug_drawing_enabled; }
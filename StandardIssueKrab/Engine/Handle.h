@@ -0,0 +1,143 @@
+#pragma once
+
+/*
+* Unique, versioned 32-bit identifier for an object owned by a manager, like
+* Collision::BVHandle is for BVH nodes. The index selects a slot in the owner's
+* HandleTable, and the version must match the slot's, so a handle to a
+* destroyed object resolves to nullptr instead of to whatever reuses its slot.
+*
+* Holding a handle instead of a pointer lets the owner move the object, e.g.
+* to compact its pool, since only the table's slot needs to be updated.
+*
+* The type parameter only keeps handles to different types apart.
+*/
+template<class T>
+union Handle
+{
+	static constexpr Uint32 INDEX_BITS = 20;
+	static constexpr Uint32 VERSION_BITS = 32 - INDEX_BITS;
+	static constexpr Uint32 MAX_INDEX = (1u << INDEX_BITS) - 2; // all ones is the null handle
+	static constexpr Uint32 VERSION_MASK = (1u << VERSION_BITS) - 1;
+	static constexpr Uint32 NULL_HANDLE = ~0u;
+
+	struct Info
+	{
+		Uint32 index : INDEX_BITS;
+		Uint32 version : VERSION_BITS; // wraps around, see HandleTable
+	};
+
+	Uint32 handle = NULL_HANDLE;
+	Info   info;
+
+	constexpr Handle() = default;
+	constexpr Handle(Uint32 idx, Uint32 vr) : info{ idx, vr } {}
+
+	Bool IsNull() const noexcept { return handle == NULL_HANDLE; }
+	explicit operator Bool() const noexcept { return not IsNull(); }
+
+	auto operator==(Handle const& other) const { return handle == other.handle; }
+};
+
+
+/*
+* Maps handles to the current address of their object in O(1).
+*
+* Freed slots are reused oldest first, so a slot goes through all of its
+* 2^VERSION_BITS versions only after that many creations and releases of
+* objects in it. Do not hold a handle to a destroyed object for that long.
+*/
+template<class T>
+class HandleTable
+{
+	static constexpr Uint32 NULL_INDEX = ~0u;
+
+	struct Slot
+	{
+		T*	   object = nullptr;
+		Uint32 version = 0;
+		Uint32 next_free = NULL_INDEX;
+	};
+
+	Vector<Slot> slots;
+	Uint32 free_head = NULL_INDEX;
+	Uint32 free_tail = NULL_INDEX;
+	Uint32 live_count = 0;
+
+public:
+	Handle<T> Create(T* object) {
+		SIK_ASSERT(object != nullptr, "Handles must refer to an object.");
+
+		Uint32 index = free_head;
+		if (index == NULL_INDEX) {
+			SIK_ASSERT(slots.size() <= Handle<T>::MAX_INDEX, "Out of handles.");
+			index = static_cast<Uint32>(slots.size());
+			slots.emplace_back();
+		}
+		else {
+			free_head = slots[index].next_free;
+			if (free_head == NULL_INDEX) {
+				free_tail = NULL_INDEX;
+			}
+		}
+
+		Slot& slot = slots[index];
+		slot.object = object;
+		slot.next_free = NULL_INDEX;
+		++live_count;
+		return Handle<T>{ index, slot.version };
+	}
+
+	// Returns false for a stale or null handle, which is left alone
+	Bool Release(Handle<T> handle) noexcept {
+		if (not IsValid(handle)) { return false; }
+
+		Uint32 const index = handle.info.index;
+		Slot& slot = slots[index];
+		slot.object = nullptr;
+		slot.version = (slot.version + 1) & Handle<T>::VERSION_MASK;
+		PushFree(index);
+		--live_count;
+		return true;
+	}
+
+	// Returns nullptr for a stale or null handle
+	T* Resolve(Handle<T> handle) const noexcept {
+		return IsValid(handle) ? slots[handle.info.index].object : nullptr;
+	}
+
+	// Points a live handle at the new address of its object
+	void Relocate(Handle<T> handle, T* object) noexcept {
+		SIK_ASSERT(IsValid(handle), "Relocating a stale handle.");
+		slots[handle.info.index].object = object;
+	}
+
+	Bool IsValid(Handle<T> handle) const noexcept {
+		return not handle.IsNull()
+			&& handle.info.index < slots.size()
+			&& slots[handle.info.index].version == handle.info.version
+			&& slots[handle.info.index].object != nullptr;
+	}
+
+	// Releases every live handle, keeping the slots
+	void Clear() noexcept {
+		for (Uint32 i = 0; i < slots.size(); ++i) {
+			if (slots[i].object != nullptr) {
+				Release(Handle<T>{ i, slots[i].version });
+			}
+		}
+	}
+
+	Uint32 Size() const noexcept { return live_count; }
+	Uint32 Capacity() const noexcept { return static_cast<Uint32>(slots.size()); }
+
+private:
+	void PushFree(Uint32 index) noexcept {
+		if (free_tail == NULL_INDEX) {
+			free_head = index;
+		}
+		else {
+			slots[free_tail].next_free = index;
+		}
+		free_tail = index;
+	}
+};
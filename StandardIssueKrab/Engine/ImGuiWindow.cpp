@@ -10,6 +10,8 @@
 #include <commdlg.h>
 
 #include "MemoryResources.h"
+#include "MemoryManager.h"
+#include "AllocationAudit.h"
 #include "GraphicsManager.h"
 #include "InputManager.h"
 #include "GameObjectManager.h"
@@ -34,6 +36,8 @@ static bool show_graphics_functions = false;
 static bool show_camera_functions = false;
 static bool show_scene_editor = false;
 static bool show_timer_tool = false;
+static bool show_physics_stats = false;
+static bool show_memory_budgets = false;
 
 #ifdef GAME_COMPONENT_LIST_FILE
     #define REGISTER_COMPONENT(component) class component;
@@ -222,6 +226,8 @@ void ImGuiWindow::ShowMenu() {
             ImGui::MenuItem("Audio",       NULL, &show_audio_functions);
             ImGui::MenuItem("Graphics",    NULL, &show_graphics_functions);
             ImGui::MenuItem("Performance", NULL, &show_performance);
+            ImGui::MenuItem("Physics",     NULL, &show_physics_stats);
+            ImGui::MenuItem("Memory",      NULL, &show_memory_budgets);
             ImGui::MenuItem("Camera",      NULL, &show_camera_functions);
             ImGui::MenuItem("SceneEditor", NULL, &show_scene_editor);
             ImGui::MenuItem("Timer",       NULL, &show_timer_tool);
@@ -531,18 +537,12 @@ void ImGuiWindow::ShowObjectComponent(GameObject* GameObject)
         }
 
         // Game side component
-        for (auto comp = GameObject->GetComponentArray().begin(); comp != GameObject->GetComponentArray().end(); ++comp) {
+        Component* p_comp = GameObject->RemoveComponent(ComponentTypeFromName(curr_comp_name));
+        if (p_comp != nullptr) {
+            p_game_obj_manager->GetComponentStorage().Destroy(p_comp);
 
-            // find comp
-            if (std::strcmp(comp->get()->GetName(), curr_comp_name) != 0) continue;               
-
-            // delete comp from array
-            comp->release();
-            GameObject->GetComponentArray().erase(comp);
-                
             // add to hashmap for removal
             p_world_editor->RemoveComp(GameObject, ToStringID(curr_comp_name));
-            break;
         }
     }
 }
@@ -857,6 +857,117 @@ void ImGuiWindow::ShowPerformance() {
     ImGui::End();
 }
 
+void ImGuiWindow::ShowPhysicsStats() {
+    PhysicsStats const& stats = p_physics_manager->GetStats();
+
+    ImGui::Begin("Physics Stats");
+
+    // One sample per rendered frame is plenty for eyeballing spikes
+    physics_step_ms.push_back(stats.total_ms);
+    if (physics_step_ms.size() > 240) {
+        physics_step_ms.erase(physics_step_ms.begin());
+    }
+    ImGui::PlotLines("Step (ms)", physics_step_ms.data(), static_cast<int>(physics_step_ms.size()), 0, NULL, 0.0f, 8.0f, ImVec2(0, 80.0f));
+
+    ImGui::Text("Step #%llu", static_cast<unsigned long long>(p_physics_manager->GetStepCount()));
+    ImGui::Separator();
+
+    ImGui::Text("Tombstones:   %6.3f ms", stats.tombstone_ms);
+    ImGui::Text("Broadphase:   %6.3f ms", stats.broadphase_ms);
+    ImGui::Text("Narrowphase:  %6.3f ms", stats.narrowphase_ms);
+    ImGui::Text("Solver:       %6.3f ms", stats.solver_ms);
+    ImGui::Text("Integration:  %6.3f ms", stats.integration_ms);
+    ImGui::Text("Total:        %6.3f ms", stats.total_ms);
+    ImGui::Separator();
+
+    ImGui::Text("Moved bodies:      %u", stats.moved_bodies);
+    ImGui::Text("BVH nodes visited: %u", stats.bvh_nodes_visited);
+    ImGui::Text("Candidate pairs:   %u", stats.candidate_pairs);
+    ImGui::Text("Manifolds:         %u", stats.manifolds);
+    ImGui::Text("Speculative:       %u", stats.speculative_contacts);
+    ImGui::Text("Contacts:          %u", stats.contacts);
+    ImGui::Text("Solver iterations: %u", stats.solver_iterations);
+    ImGui::Text("Skipped (LOD):     %u", stats.skipped_bodies);
+    ImGui::Text("Frozen (LOD):      %u", stats.frozen_bodies);
+    ImGui::Text("Force fields:      %u (%u bodies)", p_physics_manager->GetForceFields().Size(), stats.field_bodies);
+    ImGui::Separator();
+
+    PhysicsManager::SimLODSettings& lod = p_physics_manager->GetSimLODSettings();
+    ImGui::Checkbox("Simulation LOD", &lod.enabled);
+    ImGui::SameLine(); HelpMarker("Dynamic bodies far from the camera are stepped at half or quarter rate, or frozen.");
+    ImGui::DragFloat("Half rate dist", &lod.half_rate_distance, 1.0f, 0.0f, 1000.0f);
+    ImGui::DragFloat("Quarter rate dist", &lod.quarter_rate_distance, 1.0f, 0.0f, 1000.0f);
+    ImGui::DragFloat("Frozen dist", &lod.frozen_distance, 1.0f, 0.0f, 1000.0f);
+    ImGui::Separator();
+
+    if (ImGui::Button("Dump CSV")) {
+        p_physics_manager->DumpStatsCSV("physics_stats.csv");
+    }
+    ImGui::SameLine(); HelpMarker("Writes the last ~10 seconds of fixed steps to physics_stats.csv in the working directory.");
+
+    ImGui::End();
+}
+
+void ImGuiWindow::ShowMemoryBudgets() {
+    static constexpr float MiB = 1024.0f * 1024.0f;
+
+    ImGui::Begin("Memory Budgets");
+
+    for (Uint32 i = 0; i < static_cast<Uint32>(MemoryBudget::Count); ++i) {
+        BudgetMemoryResource const& budget = p_memory_manager->GetBudget(static_cast<MemoryBudget>(i));
+        float const current = static_cast<float>(budget.Current()) / MiB;
+        float const peak = static_cast<float>(budget.Peak()) / MiB;
+        float const limit = static_cast<float>(budget.Limit()) / MiB;
+
+        ImGui::Text("%-10s %8.2f MiB (peak %8.2f MiB)", budget.Name(), current, peak);
+        if (budget.Limit() != BudgetMemoryResource::NO_LIMIT) {
+            char overlay[32];
+            snprintf(overlay, sizeof(overlay), "%.0f / %.0f MiB", current, limit);
+            ImGui::ProgressBar(std::min(current / limit, 1.0f), ImVec2(-1.0f, 0.0f), overlay);
+        }
+    }
+    ImGui::Separator();
+
+    float const frame_used = static_cast<float>(p_memory_manager->FrameBytesUsed()) / MiB;
+    float const frame_peak = static_cast<float>(p_memory_manager->FrameBytesPeak()) / MiB;
+    float const frame_capacity = static_cast<float>(p_memory_manager->FrameBytesCapacity()) / MiB;
+    ImGui::Text("%-10s %8.2f MiB (peak %8.2f MiB)", "Frame", frame_used, frame_peak);
+    if (frame_capacity > 0.0f) {
+        char overlay[32];
+        snprintf(overlay, sizeof(overlay), "peak %.2f / %.0f MiB", frame_peak, frame_capacity);
+        ImGui::ProgressBar(std::min(frame_peak / frame_capacity, 1.0f), ImVec2(-1.0f, 0.0f), overlay);
+    }
+    ImGui::Separator();
+
+    if (AllocationAudit::IsEnabled()) {
+        AllocationAudit::FrameCounts const last = AllocationAudit::LastFrame();
+        ImGui::Text("Heap allocations last frame: %llu (%llu bytes), frees: %llu",
+            static_cast<unsigned long long>(last.allocations),
+            static_cast<unsigned long long>(last.bytes),
+            static_cast<unsigned long long>(last.frees));
+
+        static const char* audit_modes[] = { "Off", "Report", "Assert" };
+        int audit_mode = static_cast<int>(AllocationAudit::GetMode());
+        if (ImGui::Combo("Audit", &audit_mode, audit_modes, IM_ARRAYSIZE(audit_modes))) {
+            AllocationAudit::SetMode(static_cast<AllocationAudit::Mode>(audit_mode));
+            AllocationAudit::Rearm();
+        }
+        ImGui::SameLine(); HelpMarker("Reports frames which allocate from the heap after a warmup, with their most common callsites.");
+        ImGui::Separator();
+    }
+
+    if (ImGui::Button("Reset peaks")) {
+        p_memory_manager->ResetBudgetPeaks();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Dump CSV")) {
+        p_memory_manager->DumpBudgets("memory_budgets.csv");
+    }
+    ImGui::SameLine(); HelpMarker("Writes every budget's current, peak and limit bytes to memory_budgets.csv in the working directory.");
+
+    ImGui::End();
+}
+
 void ImGuiWindow::ShowGriphicsFunctions() {
 
     // pointers to toggle
@@ -1086,6 +1197,8 @@ void ImGuiWindow::Render() {
 
     if(show_audio_functions)    ShowAudioFunctions();
     if(show_performance)        ShowPerformance();
+    if(show_physics_stats)      ShowPhysicsStats();
+    if(show_memory_budgets)     ShowMemoryBudgets();
     if(show_graphics_functions) ShowGriphicsFunctions();
     if(show_camera_functions)   ShowCameraControls();   
     if(show_scene_editor)       ShowSceneEditor();
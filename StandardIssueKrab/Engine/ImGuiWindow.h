@@ -12,6 +12,7 @@ private:
     Vector<String> PrototypeNames;
 #endif // _PROTOTYPE
     Vector<float> fps;
+    Vector<float> physics_step_ms;
     int total_time;
     char* current_filename;
 
@@ -19,6 +20,8 @@ private:
     void ShowSceneEditor();
     void ShowMenu();
     void ShowPerformance();
+    void ShowPhysicsStats();
+    void ShowMemoryBudgets();
     void ShowAudioFunctions();
     void ShowGriphicsFunctions();
     void ShowCameraControls();
@@ -1,2 +1,125 @@
 #include "stdafx.h"
-#include "MemoryManager.h"
\ No newline at end of file
+#include "MemoryManager.h"
+
+#include <fstream>
+
+// Starting limits, to be tuned from dumped budgets. Going over only warns.
+static constexpr SizeT MiB = 1024ull * 1024ull;
+static constexpr SizeT PHYSICS_LIMIT   = 64 * MiB;
+static constexpr SizeT RENDER_LIMIT    = 128 * MiB;
+static constexpr SizeT SCRIPTING_LIMIT = 32 * MiB;
+static constexpr SizeT RESOURCES_LIMIT = 512 * MiB;
+static constexpr SizeT GUI_LIMIT       = 16 * MiB;
+static constexpr SizeT SCENE_LIMIT     = 64 * MiB;
+
+// First chunk of the scene arena. Later chunks grow geometrically.
+static constexpr SizeT SCENE_INITIAL_CHUNK = 1 * MiB;
+
+////////////////////////////////////////////////////////////////////////////
+// SCOPED RESOURCE
+////////////////////////////////////////////////////////////////////////////
+
+MemoryManager::ScopedResource::ScopedResource(MemoryResource* resource) {
+	p_memory_manager->PushResource(resource);
+}
+
+MemoryManager::ScopedResource::ScopedResource(MemoryBudget budget) {
+	p_memory_manager->PushResource(&p_memory_manager->GetBudget(budget));
+}
+
+MemoryManager::ScopedResource::~ScopedResource() {
+	p_memory_manager->PopResource();
+}
+
+////////////////////////////////////////////////////////////////////////////
+// MEMORY MANAGER
+////////////////////////////////////////////////////////////////////////////
+
+// Budgets sit on new_delete_resource rather than the default resource, since
+// they may be used from worker threads and the default resource may be a 
+// (non thread-safe) DebugMemoryResource. They do their own leak reporting.
+MemoryManager::MemoryManager()
+	: resource_stack{},
+	budgets{ {
+		BudgetMemoryResource{ "Physics",   PHYSICS_LIMIT,   std::pmr::new_delete_resource() },
+		BudgetMemoryResource{ "Render",    RENDER_LIMIT,    std::pmr::new_delete_resource() },
+		BudgetMemoryResource{ "Scripting", SCRIPTING_LIMIT, std::pmr::new_delete_resource() },
+		BudgetMemoryResource{ "Resources", RESOURCES_LIMIT, std::pmr::new_delete_resource() },
+		BudgetMemoryResource{ "GUI",       GUI_LIMIT,       std::pmr::new_delete_resource() },
+		BudgetMemoryResource{ "Scene",     SCENE_LIMIT,     std::pmr::new_delete_resource() }
+	} },
+	scene_chunks{ SCENE_INITIAL_CHUNK, &GetBudget(MemoryBudget::Scene) },
+	scene_pool{ &scene_chunks }
+{
+	resource_stack[0] = std::pmr::get_default_resource();
+	stack_size = 1;
+}
+
+MemoryManager::~MemoryManager() {
+	SIK_ASSERT(stack_size == 1, "Allocator stack was not popped back to the default resource.");
+}
+
+void MemoryManager::PushResource(MemoryResource* resource) {
+	SIK_ASSERT(resource, "Pushed a null memory resource.");
+	SIK_ASSERT(stack_size < MAX_STACK_DEPTH, "Allocator stack is full.");
+
+	resource_stack[stack_size++] = resource;
+	std::pmr::set_default_resource(resource);
+}
+
+void MemoryManager::PopResource() {
+	SIK_ASSERT(stack_size > 1, "Popped the bottom of the allocator stack.");
+
+	--stack_size;
+	std::pmr::set_default_resource(resource_stack[stack_size - 1]);
+}
+
+void MemoryManager::ResetBudgetPeaks() noexcept {
+	for (BudgetMemoryResource& budget : budgets) {
+		budget.ResetPeak();
+	}
+	frame_peak_bytes = FrameBytesUsed();
+}
+
+Bool MemoryManager::DumpBudgets(const char* filepath) const {
+	std::ofstream file{ filepath };
+	if (not file) {
+		SIK_ERROR("Failed to open \"{}\". Memory budgets not written.", filepath);
+		return false;
+	}
+
+	file << "budget,current_bytes,peak_bytes,limit_bytes,allocations\n";
+	for (BudgetMemoryResource const& budget : budgets) {
+		file << budget.Name() << ','
+			<< budget.Current() << ','
+			<< budget.Peak() << ','
+			<< budget.Limit() << ','
+			<< budget.AllocationCount() << '\n';
+	}
+	// Frame resource allocations are not counted
+	file << "Frame," << FrameBytesUsed() << ',' << FrameBytesPeak() << ',' << FrameBytesCapacity() << ",0\n";
+
+	SIK_INFO("Wrote {} memory budgets to \"{}\"", budgets.size(), filepath);
+	return true;
+}
+
+void MemoryManager::CreateFrameResource(SizeT bytes_per_frame) {
+	SIK_ASSERT(not frame_resource, "Frame resource was already created.");
+
+	SizeT const total = bytes_per_frame * FRAME_BUFFER_COUNT;
+	frame_memory = std::make_unique<Byte[]>(total);
+	frame_resource = std::make_unique<FrameMemoryResource>(frame_memory.get(), total);
+}
+
+void MemoryManager::SwapFrameBuffers() noexcept {
+	if (not frame_resource) { return; }
+
+	frame_peak_bytes = std::max(frame_peak_bytes, frame_resource->CurrentBufferSize());
+	frame_resource->SwapBuffers();
+}
+
+void MemoryManager::ReleaseSceneResource() noexcept {
+	// Pool first, so it does not hold on to blocks of freed chunks
+	scene_pool.Release();
+	scene_chunks.Release();
+}
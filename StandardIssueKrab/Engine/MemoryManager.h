@@ -1,28 +1,153 @@
 #pragma once
 
+#include "MemoryResources.h"
+
+// Subsystems with their own memory budget
+enum class MemoryBudget : Uint32 {
+	Physics = 0,
+	Render,
+	Scripting,
+	Resources,
+	GUI,
+	Scene,
+
+	Count
+};
+
 /*
 * This class manages all allocations throughout the program by holding
 * handles to one or more polymorphic memory resources.
+*
+* Resources are kept on a stack: the top one is the current resource, used by
+* GetCurrentAllocator. Pushing a resource also makes it the pmr default resource
+* until it is popped, so containers default-constructed in that scope (e.g. the
+* members of a manager) keep allocating from it for their whole lifetime. Use a
+* ScopedResource rather than pushing and popping by hand.
+*
+* Each subsystem also has a budget: a BudgetMemoryResource which tracks the
+* current and peak bytes allocated through it, and warns when it goes over its
+* limit. Dump the budgets after a play session to size arenas from real data.
+*
+* Only push and pop from the main thread, since the default resource is global.
+*
+* The frame resource is for transient data that only lives for the current 
+* frame. It is double-buffered and swapped at the end of every frame, so 
+* anything allocated from it stays valid until the end of the next frame. It is
+* not thread-safe, and a full buffer throws std::bad_alloc like any 
+* LinearMemoryResource, so watch its peak in the Memory window.
+*
+* The scene resource holds what game objects own: the objects' names and
+* component lists, and their game-side components. It is a pool on top of a
+* ChunkMemoryResource, charged to the Scene budget. Objects deleted during a
+* scene go back to the pool, and once the last game object is gone the 
+* GameObjectManager releases the whole arena in one call instead of freeing
+* each block. Anything allocated from it must therefore be owned by a game
+* object. Resources loaded while building a scene do not belong here. Not
+* thread-safe.
 */
 class MemoryManager
 {
+public:
+	static constexpr SizeT MAX_STACK_DEPTH = 16;
+	static constexpr SizeT FRAME_BUFFER_COUNT = 2;
+
+	using FrameMemoryResource = MultiBufferMemoryResource<FRAME_BUFFER_COUNT>;
+
+	// Pushes a resource for the lifetime of this object
+	class ScopedResource
+	{
+	public:
+		explicit ScopedResource(MemoryResource* resource);
+		explicit ScopedResource(MemoryBudget budget);
+		~ScopedResource();
+
+		ScopedResource(ScopedResource const&) = delete;
+		ScopedResource& operator=(ScopedResource const&) = delete;
+	};
+
 private:
-	// TODO : create interface for an "allocator stack"
-	MemoryResource* current_resource = std::pmr::get_default_resource();
+	Array<MemoryResource*, MAX_STACK_DEPTH> resource_stack;
+	SizeT stack_size = 0;
+
+	Array<BudgetMemoryResource, static_cast<SizeT>(MemoryBudget::Count)> budgets;
+
+	UniquePtr<Byte[]>				frame_memory;
+	UniquePtr<FrameMemoryResource>	frame_resource;
+	SizeT							frame_peak_bytes = 0;
+
+	ChunkMemoryResource				scene_chunks;
+	PoolMemoryResource				scene_pool;
 
 public:
-	// Ctors and Dtor defaulted
+	MemoryManager();
+	~MemoryManager();
+
+	MemoryManager(MemoryManager const&) = delete;
+	MemoryManager& operator=(MemoryManager const&) = delete;
 
-	// Returns a polymorphic allocator that allocates from the current_resource
+	// Returns a polymorphic allocator that allocates from the current resource
 	PolymorphicAllocator GetCurrentAllocator() const noexcept {
-		return std::pmr::polymorphic_allocator<>(current_resource);
+		return std::pmr::polymorphic_allocator<>(resource_stack[stack_size - 1]);
 	}
 
 	// Helper to convert default resource into a pmr allocator that uses it
 	static PolymorphicAllocator GetDefaultAllocator() noexcept {
 		return std::pmr::polymorphic_allocator<>(std::pmr::get_default_resource());
 	}
+
+	// Makes resource the current (and default) resource until the matching PopResource
+	void PushResource(MemoryResource* resource);
+	void PopResource();
+
+	// Budgets
+	BudgetMemoryResource& GetBudget(MemoryBudget budget) noexcept {
+		return budgets[static_cast<SizeT>(budget)];
+	}
+	BudgetMemoryResource const& GetBudget(MemoryBudget budget) const noexcept {
+		return budgets[static_cast<SizeT>(budget)];
+	}
+	PolymorphicAllocator GetBudgetAllocator(MemoryBudget budget) noexcept {
+		return std::pmr::polymorphic_allocator<>(&GetBudget(budget));
+	}
+	void SetBudgetLimit(MemoryBudget budget, SizeT limit_bytes) noexcept {
+		GetBudget(budget).SetLimit(limit_bytes);
+	}
+	void ResetBudgetPeaks() noexcept;
+
+	// Writes every budget's current, peak and limit bytes as CSV
+	Bool DumpBudgets(const char* filepath) const;
+
+	// Frame resource. Until it is created, the frame allocator falls back to 
+	// the default resource.
+	void CreateFrameResource(SizeT bytes_per_frame);
+	void SwapFrameBuffers() noexcept;
+	PolymorphicAllocator GetFrameAllocator() const noexcept {
+		return frame_resource ? std::pmr::polymorphic_allocator<>(frame_resource.get())
+			: GetDefaultAllocator();
+	}
+	SizeT FrameBytesUsed() const noexcept { return frame_resource ? frame_resource->CurrentBufferSize() : 0; }
+	SizeT FrameBytesPeak() const noexcept { return frame_peak_bytes; }
+	SizeT FrameBytesCapacity() const noexcept { return frame_resource ? frame_resource->BufferCapacity() : 0; }
+
+	// Scene resource
+	MemoryResource* GetSceneResource() noexcept { return &scene_pool; }
+	PolymorphicAllocator GetSceneAllocator() noexcept {
+		return std::pmr::polymorphic_allocator<>(&scene_pool);
+	}
+	// Frees everything allocated from the scene resource at once, without 
+	// calling destructors. Only call when nothing allocated from it is alive.
+	void ReleaseSceneResource() noexcept;
 };
 
+// pmr allocators do not propagate on assignment, so a container can only be
+// moved onto another resource by rebuilding it. Drops the container's contents.
+// Used to put member containers which are refilled every step on the frame 
+// resource, e.g. RebindAllocator(results, p_memory_manager->GetFrameAllocator())
+template<class Container>
+void RebindAllocator(Container& container, PolymorphicAllocator alloc) {
+	std::destroy_at(&container);
+	std::construct_at(&container, alloc);
+}
+
 //Declared as an extern variable so it can be accessed throughout the project
-extern MemoryManager* p_memory_manager;
\ No newline at end of file
+extern MemoryManager* p_memory_manager;
@@ -1,12 +1,30 @@
 #include "stdafx.h"
 #include "MemoryResources.h"
 
+////////////////////////////////////////////////////////////////////////////////
+// Parallel Job Scope
+////////////////////////////////////////////////////////////////////////////////
+static thread_local Uint32 parallel_job_depth = 0;
+
+ParallelJobScope::ParallelJobScope() noexcept {
+	++parallel_job_depth;
+}
+
+ParallelJobScope::~ParallelJobScope() noexcept {
+	--parallel_job_depth;
+}
+
+bool ParallelJobScope::Active() noexcept {
+	return parallel_job_depth > 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Debug Memory Resource
 ////////////////////////////////////////////////////////////////////////////////
 DebugMemoryResource::DebugMemoryResource(const char* name, Flag flag, std::pmr::memory_resource* upstream)
 	: upstream_{ upstream }, name_{ name }, 
-	currently_allocated_bytes_{ 0 }, flag_ { flag }	
+	currently_allocated_bytes_{ 0 }, frame_allocations_{ 0 }, frame_bytes_{ 0 },
+	flag_ { flag }	
 { }
 
 DebugMemoryResource::~DebugMemoryResource() noexcept {
@@ -17,15 +35,19 @@ DebugMemoryResource::~DebugMemoryResource() noexcept {
 
 
 void* DebugMemoryResource::do_allocate(size_t bytes, size_t alignment) {
+	SIK_ASSERT(!ParallelJobScope::Active(), "DebugMemoryResource is not thread-safe, used from a parallel job");
 	void* ptr = upstream_->allocate(bytes, alignment);
 	if (flag_ == Flag::LogAndTrack) {
 		SIK_INFO("{}: + Allocating {} bytes @ {}", name_, bytes, ptr);
 	}
 	currently_allocated_bytes_ += bytes;
+	++frame_allocations_;
+	frame_bytes_ += bytes;
 	return ptr;
 }
 
 void DebugMemoryResource::do_deallocate(void* ptr, size_t bytes, size_t alignment) {
+	SIK_ASSERT(!ParallelJobScope::Active(), "DebugMemoryResource is not thread-safe, used from a parallel job");
 	if (flag_ == Flag::LogAndTrack) {
 		SIK_INFO("{}: - Deallocating {} bytes @ {}", name_, bytes, ptr);
 	}
@@ -59,3 +81,278 @@ void* LinearMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment
 		throw std::bad_alloc{};
 	}
 }
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Thread Index
+////////////////////////////////////////////////////////////////////////////////
+// Indices of exited threads are reused, so a pool of short-lived threads does
+// not run out of slots. Uses std::vector so it never goes through the default
+// pmr resource, which may be a (non thread-safe) DebugMemoryResource.
+struct ThreadIndexRegistry {
+	std::mutex mtx;
+	std::vector<std::size_t> free_indices;
+	std::size_t next_index = 0ull;
+
+	static ThreadIndexRegistry& Get() {
+		static ThreadIndexRegistry registry;
+		return registry;
+	}
+};
+
+struct ThreadIndexHolder {
+	std::size_t index;
+
+	ThreadIndexHolder() {
+		ThreadIndexRegistry& reg = ThreadIndexRegistry::Get();
+		std::scoped_lock lock{ reg.mtx };
+		if (reg.free_indices.empty()) {
+			index = reg.next_index++;
+		}
+		else {
+			index = reg.free_indices.back();
+			reg.free_indices.pop_back();
+		}
+	}
+
+	~ThreadIndexHolder() {
+		ThreadIndexRegistry& reg = ThreadIndexRegistry::Get();
+		std::scoped_lock lock{ reg.mtx };
+		reg.free_indices.push_back(index);
+	}
+};
+
+std::size_t ThisThreadIndex() noexcept {
+	thread_local ThreadIndexHolder const holder{};
+	return holder.index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Thread Local Linear Memory Resource
+////////////////////////////////////////////////////////////////////////////////
+ThreadLocalLinearMemoryResource::ThreadLocalLinearMemoryResource(std::size_t per_thread_capacity,
+	std::pmr::memory_resource* upstream)
+	: upstream_{ upstream },
+	per_thread_capacity_{ per_thread_capacity },
+	epoch_{ 0ull },
+	upstream_mtx_{},
+	slots_{}
+{ }
+
+ThreadLocalLinearMemoryResource::~ThreadLocalLinearMemoryResource() noexcept {
+	for (Slot* slot : slots_) {
+		if (slot == nullptr) { continue; }
+
+		void* const buffer = slot->buffer;
+		std::destroy_at(slot);
+		upstream_->deallocate(buffer, per_thread_capacity_, alignof(std::max_align_t));
+		upstream_->deallocate(slot, sizeof(Slot), alignof(Slot));
+	}
+}
+
+std::size_t ThreadLocalLinearMemoryResource::CurrentThreadSize() const noexcept {
+	std::size_t const idx = ThisThreadIndex();
+	if (idx >= MAX_MEMORY_THREADS) { return 0ull; }
+
+	Slot const* slot = slots_[idx];
+	if (slot == nullptr || slot->epoch != epoch_.load(std::memory_order_acquire)) {
+		return 0ull;
+	}
+	return slot->linear.Size();
+}
+
+void* ThreadLocalLinearMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+	Slot& slot = CurrentSlot();
+
+	// Clear lazily if a Reset happened since this thread last allocated
+	std::uint64_t const epoch = epoch_.load(std::memory_order_acquire);
+	if (slot.epoch != epoch) {
+		slot.linear.Clear();
+		slot.epoch = epoch;
+	}
+
+	return slot.linear.allocate(bytes, alignment);
+}
+
+ThreadLocalLinearMemoryResource::Slot& ThreadLocalLinearMemoryResource::CurrentSlot() {
+	std::size_t const idx = ThisThreadIndex();
+	if (idx >= MAX_MEMORY_THREADS) [[unlikely]] {
+		SIK_ASSERT(false, "Too many threads allocating from per-thread memory resources.");
+		throw std::bad_alloc{};
+	}
+
+	// Only this thread ever reads or writes its own slot pointer
+	if (slots_[idx] == nullptr) [[unlikely]] {
+		std::scoped_lock lock{ upstream_mtx_ };
+		void* const buffer = upstream_->allocate(per_thread_capacity_, alignof(std::max_align_t));
+		Slot* const slot = static_cast<Slot*>(upstream_->allocate(sizeof(Slot), alignof(Slot)));
+		slots_[idx] = std::construct_at(slot, Slot{
+			.linear = LinearMemoryResource{ buffer, per_thread_capacity_ },
+			.buffer = buffer,
+			.epoch = epoch_.load(std::memory_order_acquire)
+			});
+	}
+	return *slots_[idx];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Thread Caching Pool Memory Resource
+////////////////////////////////////////////////////////////////////////////////
+ThreadCachingPoolMemoryResource::ThreadCachingPoolMemoryResource(std::size_t initial_chunk_capacity,
+	std::pmr::memory_resource* upstream)
+	: upstream_{ upstream },
+	mtx_{},
+	chunk_{ initial_chunk_capacity, upstream },
+	shared_{},
+	caches_{}
+{ }
+
+void* ThreadCachingPoolMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+	std::size_t const size = std::max(bytes, alignment);
+	if (size > MAX_BLOCK) [[unlikely]] {
+		std::scoped_lock lock{ mtx_ };
+		return upstream_->allocate(bytes, alignment);
+	}
+
+	std::size_t const class_idx = ClassIndex(size);
+	FreeList& list = CurrentCache().lists[class_idx];
+	if (list.head == nullptr) {
+		Refill(list, class_idx);
+	}
+
+	FreeBlock* const block = list.head;
+	list.head = block->next;
+	--list.count;
+	return block;
+}
+
+void ThreadCachingPoolMemoryResource::do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) {
+	std::size_t const size = std::max(bytes, alignment);
+	if (size > MAX_BLOCK) [[unlikely]] {
+		std::scoped_lock lock{ mtx_ };
+		upstream_->deallocate(ptr, bytes, alignment);
+		return;
+	}
+
+	std::size_t const class_idx = ClassIndex(size);
+	FreeList& list = CurrentCache().lists[class_idx];
+
+	list.head = std::construct_at(static_cast<FreeBlock*>(ptr), FreeBlock{ list.head });
+	++list.count;
+
+	if (list.count > 2ull * BATCH) {
+		GiveBack(list, class_idx);
+	}
+}
+
+ThreadCachingPoolMemoryResource::Cache& ThreadCachingPoolMemoryResource::CurrentCache() {
+	std::size_t const idx = ThisThreadIndex();
+	if (idx >= MAX_MEMORY_THREADS) [[unlikely]] {
+		SIK_ASSERT(false, "Too many threads allocating from per-thread memory resources.");
+		throw std::bad_alloc{};
+	}
+
+	// Only this thread ever reads or writes its own cache pointer
+	if (caches_[idx] == nullptr) [[unlikely]] {
+		std::scoped_lock lock{ mtx_ };
+		caches_[idx] = std::construct_at(
+			static_cast<Cache*>(chunk_.allocate(sizeof(Cache), alignof(Cache))));
+	}
+	return *caches_[idx];
+}
+
+void ThreadCachingPoolMemoryResource::Refill(FreeList& list, std::size_t class_idx) {
+	std::scoped_lock lock{ mtx_ };
+
+	FreeList& shared = shared_[class_idx];
+	if (shared.head != nullptr) {
+		// Take up to BATCH blocks from the front of the shared list
+		FreeBlock* last = shared.head;
+		std::size_t taken = 1ull;
+		while (taken < BATCH && last->next != nullptr) {
+			last = last->next;
+			++taken;
+		}
+
+		list.head = shared.head;
+		list.count = taken;
+		shared.head = last->next;
+		shared.count -= taken;
+		last->next = nullptr;
+		return;
+	}
+
+	// Carve a new batch of blocks. Blocks are aligned to their size.
+	std::size_t const block_size = ClassSize(class_idx);
+	std::byte* const mem = static_cast<std::byte*>(chunk_.allocate(block_size * BATCH, block_size));
+
+	FreeBlock* head = nullptr;
+	for (std::size_t i = BATCH; i > 0ull; --i) {
+		head = std::construct_at(reinterpret_cast<FreeBlock*>(mem + (i - 1ull) * block_size), FreeBlock{ head });
+	}
+	list.head = head;
+	list.count = BATCH;
+}
+
+void ThreadCachingPoolMemoryResource::GiveBack(FreeList& list, std::size_t class_idx) {
+	// Detach BATCH blocks from the front of the thread's list before locking
+	FreeBlock* const first = list.head;
+	FreeBlock* last = first;
+	for (std::size_t i = 1ull; i < BATCH; ++i) {
+		last = last->next;
+	}
+	list.head = last->next;
+	list.count -= BATCH;
+
+	std::scoped_lock lock{ mtx_ };
+	FreeList& shared = shared_[class_idx];
+	last->next = shared.head;
+	shared.head = first;
+	shared.count += BATCH;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Budget Memory Resource
+////////////////////////////////////////////////////////////////////////////////
+BudgetMemoryResource::BudgetMemoryResource(const char* name, std::size_t limit,
+	std::pmr::memory_resource* upstream)
+	: upstream_{ upstream },
+	name_{ name },
+	current_{ 0ull },
+	peak_{ 0ull },
+	limit_{ limit },
+	allocations_{ 0ull },
+	over_limit_{ false }
+{ }
+
+BudgetMemoryResource::~BudgetMemoryResource() noexcept {
+	if (std::size_t const lost = Current(); lost > 0) {
+		SIK_ERROR("Not all bytes were freed from budget \"{}\"! Lost {} bytes.", name_, lost);
+	}
+}
+
+void* BudgetMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+	void* ptr = upstream_->allocate(bytes, alignment);
+
+	allocations_.fetch_add(1ull, std::memory_order_relaxed);
+	std::size_t const current = current_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+	std::size_t peak = peak_.load(std::memory_order_relaxed);
+	while (current > peak && not peak_.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+
+	std::size_t const limit = Limit();
+	if (limit != NO_LIMIT && current > limit && not over_limit_.exchange(true, std::memory_order_relaxed)) {
+		SIK_WARN("Memory budget \"{}\" exceeded: {} of {} bytes in use.", name_, current, limit);
+	}
+	return ptr;
+}
+
+void BudgetMemoryResource::do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) {
+	upstream_->deallocate(ptr, bytes, alignment);
+
+	std::size_t const current = current_.fetch_sub(bytes, std::memory_order_relaxed) - bytes;
+	if (current <= Limit()) {
+		over_limit_.store(false, std::memory_order_relaxed);
+	}
+}
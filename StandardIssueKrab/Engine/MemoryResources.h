@@ -1,9 +1,34 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+#include <bit>
+
 /*
-* IMPORTANT: None of these are thread-safe!!!
+* IMPORTANT: None of these are thread-safe, except for the resources at the 
+* bottom of this file (ThreadLocalLinearMemoryResource, 
+* ThreadCachingPoolMemoryResource and BudgetMemoryResource)!!!
 */
 
+/*
+* Marks the calling thread as running a parallel job for as long as the scope
+* lives (ComponentStorage opens one around each component update it runs on a
+* worker). In debug builds, the resources which are not thread-safe assert if
+* they are used from inside such a scope.
+*/
+class ParallelJobScope
+{
+public:
+    ParallelJobScope() noexcept;
+    ~ParallelJobScope() noexcept;
+
+    ParallelJobScope(const ParallelJobScope&) = delete;
+    ParallelJobScope& operator=(const ParallelJobScope&) = delete;
+
+    // True if the calling thread is inside a ParallelJobScope
+    static bool Active() noexcept;
+};
+
 /*
 * This class can be constructed by passing another memory resource to its
 * constructor in order to log calls to do_allocate and do_deallocate.
@@ -26,10 +51,19 @@ public:
     void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
     bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
 
+    inline const char* Name() const noexcept { return name_; }
+
+    // Allocations since the last ResetFrameCounts (see AllocationAudit)
+    inline SizeT FrameAllocations() const noexcept { return frame_allocations_; }
+    inline SizeT FrameBytes() const noexcept { return frame_bytes_; }
+    inline void ResetFrameCounts() noexcept { frame_allocations_ = 0; frame_bytes_ = 0; }
+
 private:
     std::pmr::memory_resource* upstream_;
     const char* name_;
     SizeT currently_allocated_bytes_;
+    SizeT frame_allocations_;
+    SizeT frame_bytes_;
     Flag flag_;
 };
 
@@ -136,15 +170,21 @@ public:
         }
     {}
 
+    // Returns all memory to upstream, even blocks which were not deallocated.
+    // Destructors are NOT called.
+    inline void Release() noexcept {
+        pool_.release();
+    }
+
 private:
     [[nodiscard]] void* do_allocate(std::size_t bytes, std::size_t alignment) override {
-        
+        SIK_ASSERT(!ParallelJobScope::Active(), "PoolMemoryResource used from a parallel job");
         return pool_.allocate(std::forward<std::size_t>(bytes),
             std::forward<std::size_t>(alignment));
     }
 
     void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
-        
+        SIK_ASSERT(!ParallelJobScope::Active(), "PoolMemoryResource used from a parallel job");
         pool_.deallocate(std::forward<void*>(ptr),
             std::forward<std::size_t>(bytes), 
             std::forward<std::size_t>(alignment));
@@ -207,6 +247,7 @@ public:
 
 private:
     [[nodiscard]] void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        SIK_ASSERT(!ParallelJobScope::Active(), "MultiBufferMemoryResource used from a parallel job");
         return resources_[current_idx_].allocate(bytes, alignment);
     }
     
@@ -239,6 +280,11 @@ public:
         }
     {}
 
+    // Returns every chunk to upstream at once. Destructors are NOT called.
+    inline void Release() noexcept {
+        mono_buf_.release();
+    }
+
 private:
     [[nodiscard]] void* do_allocate(std::size_t bytes, std::size_t alignment) override {
         return mono_buf_.allocate(std::forward<std::size_t>(bytes),
@@ -253,4 +299,208 @@ private:
 
 private:
     std::pmr::monotonic_buffer_resource mono_buf_;
-};
\ No newline at end of file
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+// THREAD-SAFE RESOURCES
+////////////////////////////////////////////////////////////////////////////////
+
+// Max number of live threads which may allocate from the per-thread resources
+// below at the same time
+inline constexpr std::size_t MAX_MEMORY_THREADS = 64;
+
+// Dense index of the calling thread, assigned the first time it is called on
+// that thread and released when the thread exits. Used by the per-thread 
+// resources to find the thread's slot. A new thread may inherit the slot (and
+// cached memory) of a thread which has exited.
+std::size_t ThisThreadIndex() noexcept;
+
+/*
+* A frame arena for worker threads. Each thread allocates linearly from its own
+* LinearMemoryResource, so allocations never take a lock or touch other 
+* threads' memory. Each thread's buffer (per_thread_capacity bytes) is taken 
+* from upstream the first time that thread allocates -- this is the only time a
+* lock is taken.
+* 
+* Reset is the global reset point: it frees the memory of every thread in O(1).
+* Each thread's buffer is actually cleared lazily, on its next allocation.
+* 
+* Like LinearMemoryResource, deallocate is a no-op, no destructors are called on
+* reset, and a full thread buffer throws std::bad_alloc.
+*/
+class ThreadLocalLinearMemoryResource final : public std::pmr::memory_resource
+{
+public:
+    explicit ThreadLocalLinearMemoryResource(std::size_t per_thread_capacity,
+        std::pmr::memory_resource* upstream);
+
+    ~ThreadLocalLinearMemoryResource() noexcept override;
+
+    ThreadLocalLinearMemoryResource(const ThreadLocalLinearMemoryResource&) = delete;
+    ThreadLocalLinearMemoryResource& operator=(const ThreadLocalLinearMemoryResource&) = delete;
+
+    // Frees every thread's allocations. Must only be called when no thread is
+    // still using memory from this resource (e.g. at the end of a frame).
+    inline void Reset() noexcept {
+        epoch_.fetch_add(1ull, std::memory_order_acq_rel);
+    }
+
+    inline std::size_t PerThreadCapacity() const noexcept {
+        return per_thread_capacity_;
+    }
+
+    // Returns: bytes used by the calling thread since the last Reset
+    std::size_t CurrentThreadSize() const noexcept;
+
+private:
+    struct alignas(64) Slot {
+        LinearMemoryResource linear;
+        void* buffer = nullptr;         // from upstream, returned on destruction
+        std::uint64_t epoch = 0ull;     // value of epoch_ when linear was last cleared
+    };
+
+    [[nodiscard]] void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    Slot& CurrentSlot();
+
+private:
+    std::pmr::memory_resource* upstream_;
+    std::size_t per_thread_capacity_;
+    std::atomic<std::uint64_t> epoch_;
+    std::mutex upstream_mtx_;
+    std::array<Slot*, MAX_MEMORY_THREADS> slots_;
+};
+
+
+/*
+* A thread-safe pool resource. Blocks are sized in powers of two from 
+* MIN_BLOCK to MAX_BLOCK bytes. Each thread keeps its own cache of free blocks
+* per size, so allocating and deallocating normally takes no lock.
+* 
+* Blocks move between a thread's cache and shared free lists BATCH blocks at a
+* time: a thread with an empty cache takes a batch (carving new blocks from a
+* shared ChunkMemoryResource if there are none), and a thread whose cache grows
+* past 2 * BATCH gives a batch back. Only these transfers take a lock.
+* 
+* Blocks may be freed on a different thread than the one which allocated them.
+* Requests larger than MAX_BLOCK go straight to upstream under the lock. As with
+* ChunkMemoryResource, memory is only returned to upstream on destruction.
+*/
+class ThreadCachingPoolMemoryResource final : public std::pmr::memory_resource
+{
+public:
+    static constexpr std::size_t MIN_BLOCK = 16ull;
+    static constexpr std::size_t MAX_BLOCK = 1024ull;
+    static constexpr std::size_t BATCH = 32ull;
+
+public:
+    explicit ThreadCachingPoolMemoryResource(std::size_t initial_chunk_capacity,
+        std::pmr::memory_resource* upstream);
+
+    ThreadCachingPoolMemoryResource(const ThreadCachingPoolMemoryResource&) = delete;
+    ThreadCachingPoolMemoryResource& operator=(const ThreadCachingPoolMemoryResource&) = delete;
+
+private:
+    static constexpr std::size_t NUM_CLASSES = 
+        std::bit_width(MAX_BLOCK) - std::bit_width(MIN_BLOCK) + 1;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct FreeList {
+        FreeBlock* head = nullptr;
+        std::size_t count = 0ull;
+    };
+
+    struct alignas(64) Cache {
+        std::array<FreeList, NUM_CLASSES> lists = {};
+    };
+
+    [[nodiscard]] void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    static inline std::size_t ClassIndex(std::size_t size) noexcept {
+        return size <= MIN_BLOCK ? 0ull
+            : std::bit_width(size - 1ull) - std::bit_width(MIN_BLOCK - 1ull);
+    }
+
+    static inline std::size_t ClassSize(std::size_t class_idx) noexcept {
+        return MIN_BLOCK << class_idx;
+    }
+
+    Cache& CurrentCache();
+    void Refill(FreeList& list, std::size_t class_idx);
+    void GiveBack(FreeList& list, std::size_t class_idx);
+
+private:
+    std::pmr::memory_resource* upstream_;
+    std::mutex mtx_;                                // guards everything below
+    ChunkMemoryResource chunk_;
+    std::array<FreeList, NUM_CLASSES> shared_;
+    std::array<Cache*, MAX_MEMORY_THREADS> caches_; // only touched by the owning thread after creation
+};
+
+/*
+* Tracks the bytes a subsystem allocates through it, and forwards every call to
+* upstream. Keeps the current and peak number of bytes in use, and warns once
+* each time current goes over the limit (a limit of 0 means no limit). Used by
+* the MemoryManager for per-subsystem budgets.
+* 
+* The counters are atomic, so this is thread-safe as long as upstream is.
+*/
+class BudgetMemoryResource final : public std::pmr::memory_resource
+{
+public:
+    static constexpr std::size_t NO_LIMIT = 0ull;
+
+public:
+    explicit BudgetMemoryResource(const char* name, std::size_t limit,
+        std::pmr::memory_resource* upstream);
+
+    ~BudgetMemoryResource() noexcept override;
+
+    BudgetMemoryResource(const BudgetMemoryResource&) = delete;
+    BudgetMemoryResource& operator=(const BudgetMemoryResource&) = delete;
+
+    inline const char* Name() const noexcept { return name_; }
+    inline std::size_t Current() const noexcept { return current_.load(std::memory_order_relaxed); }
+    inline std::size_t Peak() const noexcept { return peak_.load(std::memory_order_relaxed); }
+    inline std::size_t Limit() const noexcept { return limit_.load(std::memory_order_relaxed); }
+    inline std::size_t AllocationCount() const noexcept { return allocations_.load(std::memory_order_relaxed); }
+
+    inline void SetLimit(std::size_t limit) noexcept { limit_.store(limit, std::memory_order_relaxed); }
+
+    // Starts measuring the peak again from the current size
+    inline void ResetPeak() noexcept { peak_.store(Current(), std::memory_order_relaxed); }
+
+private:
+    [[nodiscard]] void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    std::pmr::memory_resource* upstream_;
+    const char* name_;
+    std::atomic<std::size_t> current_;
+    std::atomic<std::size_t> peak_;
+    std::atomic<std::size_t> limit_;
+    std::atomic<std::size_t> allocations_;  // total since construction
+    std::atomic<Bool> over_limit_;          // so each overrun is only reported once
+};
@@ -1,8 +1,13 @@
 #pragma once
 
+#include "Handle.h"
+
 class Mesh;
 class Material;
 class GameObject;
+struct MeshRenderer;
+
+using MeshRendererHandle = Handle<MeshRenderer>;
 
 struct MeshRenderer
 {
@@ -10,6 +15,7 @@ public:
 	Mesh* mesh = nullptr;
 	Material* material = nullptr;
 	GameObject* owner = nullptr;
+	MeshRendererHandle handle; // resolve with GraphicsManager::Resolve
 	bool is_valid = false;
 	bool enabled = true;
 	void Use();
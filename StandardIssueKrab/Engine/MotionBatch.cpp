@@ -0,0 +1,218 @@
+#include "stdafx.h"
+#include "MotionBatch.h"
+
+#include "SIMD.h"
+#include "RigidBody.h"
+#include "MotionProperties.h"
+
+using namespace SIMD;
+
+static inline MotionBatch::Stream Offset(MotionBatch::Stream s, Uint32 k) {
+	return static_cast<MotionBatch::Stream>(static_cast<Uint32>(s) + k);
+}
+
+
+void MotionBatch::Gather(Vector<RigidBody*> const& dynamic_bodies, Uint32 num_substeps, Float32 time_step) {
+	bodies.clear();
+	for (RigidBody* rb : dynamic_bodies) {
+		if (rb->IsEnabled() && rb->IsSteppedThisUpdate() && rb->motion_props) {
+			bodies.push_back(rb);
+		}
+	}
+
+	padded_count = (Size() + WIDTH - 1) / WIDTH * WIDTH;
+	data.assign(static_cast<SizeT>(COUNT) * padded_count, 0.0f);
+
+	// Padding lanes have h = 0 so they never move, and identity orientations
+	// so normalizing them stays finite
+	std::fill(Get(QW) + Size(), Get(QW) + padded_count, 1.0f);
+
+	Float32 const inv_substeps = 1.0f / static_cast<Float32>(num_substeps);
+
+	for (Uint32 i = 0; i < Size(); ++i) {
+		RigidBody const& rb = *bodies[i];
+		MotionProperties const& mp = *rb.motion_props;
+
+		Get(H)[i] = rb.lod_step_dt * inv_substeps;
+		Get(INV_MASS)[i] = mp.inv_mass;
+		Get(LINEAR_DAMPING)[i] = mp.linear_damping;
+		Get(ANGULAR_DAMPING)[i] = mp.angular_damping;
+		Get(GRAVITY_SCALE)[i] = mp.gravity_scale;
+
+		// 1 at full rate, 1/period for a body making up skipped steps
+		Float32 const force_scale = time_step / rb.lod_step_dt;
+		for (Uint32 k = 0; k < 3; ++k) {
+			Get(Offset(FX, k))[i] = mp.accumulated_force[k] * force_scale;
+			Get(Offset(TX, k))[i] = mp.accumulated_torque[k] * force_scale;
+		}
+	}
+}
+
+void MotionBatch::LoadState() {
+	for (Uint32 i = 0; i < Size(); ++i) {
+		RigidBody const& rb = *bodies[i];
+		MotionProperties const& mp = *rb.motion_props;
+
+		for (Uint32 k = 0; k < 3; ++k) {
+			Get(Offset(VX, k))[i] = mp.linear_velocity[k];
+			Get(Offset(WX, k))[i] = mp.angular_velocity[k];
+			Get(Offset(PX, k))[i] = rb.position[k];
+		}
+
+		Get(QW)[i] = rb.orientation.w;
+		Get(QX)[i] = rb.orientation.x;
+		Get(QY)[i] = rb.orientation.y;
+		Get(QZ)[i] = rb.orientation.z;
+	}
+}
+
+void MotionBatch::LoadInertia() {
+	for (Uint32 i = 0; i < Size(); ++i) {
+		MotionProperties const& mp = *bodies[i]->motion_props;
+
+		for (Uint32 c = 0; c < 3; ++c) {
+			for (Uint32 r = 0; r < 3; ++r) {
+				Get(Offset(I00, 3 * c + r))[i] = mp.inertia[c][r];
+				Get(Offset(INV_I00, 3 * c + r))[i] = mp.inv_inertia[c][r];
+			}
+		}
+	}
+}
+
+void MotionBatch::IntegrateForces() {
+	F4 const one = Splat(1.0f);
+	F4 const g[3] = {
+		Splat(MotionProperties::gravity.x),
+		Splat(MotionProperties::gravity.y),
+		Splat(MotionProperties::gravity.z)
+	};
+
+	for (Uint32 i = 0; i < padded_count; i += WIDTH) {
+		F4 const h = Load(Get(H) + i);
+		F4 const inv_mass = Load(Get(INV_MASS) + i);
+		F4 const gravity_scale = Load(Get(GRAVITY_SCALE) + i);
+		F4 const linear_keep = Sub(one, Load(Get(LINEAR_DAMPING) + i));
+		F4 const angular_keep = Sub(one, Load(Get(ANGULAR_DAMPING) + i));
+
+		// v += h * (g * gravity_scale + F * inv_mass), then damp
+		for (Uint32 k = 0; k < 3; ++k) {
+			Float32* v_stream = Get(Offset(VX, k)) + i;
+			F4 const f = Load(Get(Offset(FX, k)) + i);
+			F4 const a = Add(Mul(g[k], gravity_scale), Mul(f, inv_mass));
+			Store(v_stream, Mul(Add(Load(v_stream), Mul(h, a)), linear_keep));
+		}
+
+		// w += h * inv_inertia * (T - w x (inertia * w)), then damp
+		F4 w[3], t[3], iw[3];
+		for (Uint32 k = 0; k < 3; ++k) {
+			w[k] = Load(Get(Offset(WX, k)) + i);
+			t[k] = Load(Get(Offset(TX, k)) + i);
+		}
+		for (Uint32 r = 0; r < 3; ++r) {
+			iw[r] = Add(Add(
+				Mul(Load(Get(Offset(I00, r)) + i), w[0])),
+				Mul(Load(Get(Offset(I00, 3 + r)) + i), w[1])),
+				Mul(Load(Get(Offset(I00, 6 + r)) + i), w[2]));
+		}
+
+		F4 const tau[3] = {
+			Sub(t[0], Sub(Mul(w[1], iw[2]), Mul(w[2], iw[1]))),
+			Sub(t[1], Sub(Mul(w[2], iw[0]), Mul(w[0], iw[2]))),
+			Sub(t[2], Sub(Mul(w[0], iw[1]), Mul(w[1], iw[0])))
+		};
+
+		for (Uint32 r = 0; r < 3; ++r) {
+			F4 const dw = Add(Add(
+				Mul(Load(Get(Offset(INV_I00, r)) + i), tau[0])),
+				Mul(Load(Get(Offset(INV_I00, 3 + r)) + i), tau[1])),
+				Mul(Load(Get(Offset(INV_I00, 6 + r)) + i), tau[2]));
+
+			Store(Get(Offset(WX, r)) + i, Mul(Add(w[r], Mul(h, dw)), angular_keep));
+		}
+	}
+
+	// Forces and torques only act on the first substep
+	std::fill(Get(FX), Get(FX) + static_cast<SizeT>(6) * padded_count, 0.0f);
+}
+
+void MotionBatch::IntegrateVelocities() {
+	F4 const epsilon = Splat(0.0005f);
+	F4 const half = Splat(0.5f);
+
+	for (Uint32 i = 0; i < padded_count; i += WIDTH) {
+		F4 const h = Load(Get(H) + i);
+
+		// Position update. Snap back if the body barely moved.
+		F4 p[3], new_p[3];
+		F4 still = AllTrue();
+		for (Uint32 k = 0; k < 3; ++k) {
+			p[k] = Load(Get(Offset(PX, k)) + i);
+			new_p[k] = Add(p[k], Mul(h, Load(Get(Offset(VX, k)) + i)));
+			still = And(still, Less(Abs(Sub(new_p[k], p[k])), epsilon));
+		}
+		for (Uint32 k = 0; k < 3; ++k) {
+			Store(Get(Offset(PREV_PX, k)) + i, p[k]);
+			Store(Get(Offset(PX, k)) + i, Select(still, p[k], new_p[k]));
+		}
+
+		// Orientation update: q += h/2 * (0, w) * q, then normalize
+		F4 const q[4] = {
+			Load(Get(QW) + i), Load(Get(QX) + i), Load(Get(QY) + i), Load(Get(QZ) + i)
+		};
+		F4 const wx = Load(Get(WX) + i);
+		F4 const wy = Load(Get(WY) + i);
+		F4 const wz = Load(Get(WZ) + i);
+
+		F4 const dq[4] = {
+			Sub(Splat(0.0f), Add(Add(Mul(wx, q[1]), Mul(wy, q[2])), Mul(wz, q[3]))),
+			Add(Mul(q[0], wx), Sub(Mul(wy, q[3]), Mul(wz, q[2]))),
+			Add(Mul(q[0], wy), Sub(Mul(wz, q[1]), Mul(wx, q[3]))),
+			Add(Mul(q[0], wz), Sub(Mul(wx, q[2]), Mul(wy, q[1])))
+		};
+
+		F4 const half_h = Mul(half, h);
+		F4 new_q[4];
+		F4 length2 = Splat(0.0f);
+		for (Uint32 k = 0; k < 4; ++k) {
+			new_q[k] = Add(q[k], Mul(half_h, dq[k]));
+			length2 = Add(length2, Mul(new_q[k], new_q[k]));
+		}
+		F4 const inv_length = Div(Splat(1.0f), Sqrt(length2));
+
+		still = AllTrue();
+		for (Uint32 k = 0; k < 4; ++k) {
+			new_q[k] = Mul(new_q[k], inv_length);
+			still = And(still, Less(Abs(Sub(new_q[k], q[k])), epsilon));
+		}
+		for (Uint32 k = 0; k < 4; ++k) {
+			Store(Get(Offset(PREV_QW, k)) + i, q[k]);
+			Store(Get(Offset(QW, k)) + i, Select(still, q[k], new_q[k]));
+		}
+	}
+}
+
+void MotionBatch::StoreVelocities() {
+	for (Uint32 i = 0; i < Size(); ++i) {
+		MotionProperties& mp = *bodies[i]->motion_props;
+
+		mp.linear_velocity = Vec3(Get(VX)[i], Get(VY)[i], Get(VZ)[i]);
+		mp.angular_velocity = Vec3(Get(WX)[i], Get(WY)[i], Get(WZ)[i]);
+
+		mp.accumulated_force = Vec3(0);
+		mp.accumulated_torque = Vec3(0);
+	}
+}
+
+void MotionBatch::StorePoses() {
+	for (Uint32 i = 0; i < Size(); ++i) {
+		RigidBody& rb = *bodies[i];
+		MotionProperties& mp = *rb.motion_props;
+
+		mp.prev_position = Vec3(Get(PREV_PX)[i], Get(PREV_PY)[i], Get(PREV_PZ)[i]);
+		mp.prev_orientation = Quat(Get(PREV_QW)[i], Get(PREV_QX)[i], Get(PREV_QY)[i], Get(PREV_QZ)[i]);
+
+		rb.position = Vec3(Get(PX)[i], Get(PY)[i], Get(PZ)[i]);
+		rb.orientation = Quat(Get(QW)[i], Get(QX)[i], Get(QY)[i], Get(QZ)[i]);
+		SIK_ASSERT(not glm::any(glm::isnan(rb.orientation)), "Orientation was NAN");
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+struct RigidBody;
+
+/*
+* Structure-of-arrays copy of the motion state of every dynamic body which is
+* stepped this update. Integration runs 4 bodies at a time with SSE, instead of
+* one call per body through RigidBody::IntegrateForces/IntegrateVelocities.
+*
+* MotionProperties stays the authoritative copy, since the solver and gameplay
+* code read and write it directly. Per-step data (mass, damping, forces) is
+* gathered once per step. The world inertia follows the orientation, and
+* RigidBody::UpdateInternals recomputes it every substep, so it is loaded again
+* before each IntegrateForces. Velocities and poses are loaded before each
+* integration pass, since the solver and ground constraint may have changed
+* them, and written back in a single pass afterwards.
+*
+* Usage per step:
+*	batch.Gather(dynamic_bodies, num_substeps, time_step);
+*	for each substep:
+*		batch.LoadState(); batch.LoadInertia(); batch.IntegrateForces(); batch.StoreVelocities();
+*		... solve constraints ...
+*		batch.LoadState(); batch.IntegrateVelocities(); batch.StorePoses();
+*/
+class MotionBatch
+{
+public:
+	static constexpr Uint32 WIDTH = 4;
+
+	// One array per scalar. Each array is padded to a multiple of WIDTH.
+	enum Stream : Uint32 {
+		// Per-step constants
+		H, INV_MASS, LINEAR_DAMPING, ANGULAR_DAMPING, GRAVITY_SCALE,
+		FX, FY, FZ, TX, TY, TZ,
+
+		// Loaded before IntegrateForces
+		I00, I01, I02, I10, I11, I12, I20, I21, I22,				// inertia, column-major
+		INV_I00, INV_I01, INV_I02, INV_I10, INV_I11, INV_I12, INV_I20, INV_I21, INV_I22,
+
+		// Loaded every pass
+		VX, VY, VZ, WX, WY, WZ,
+		PX, PY, PZ, QW, QX, QY, QZ,
+
+		// Written by IntegrateVelocities
+		PREV_PX, PREV_PY, PREV_PZ, PREV_QW, PREV_QX, PREV_QY, PREV_QZ,
+
+		COUNT
+	};
+
+private:
+	Vector<RigidBody*> bodies;
+	Vector<Float32>    data;
+	Uint32             padded_count = 0;
+
+public:
+	// Collects enabled dynamic bodies which are stepped this update, and their
+	// per-step data. Each body integrates over lod_step_dt / num_substeps.
+	// A body at a reduced rate has summed the forces of every step it skipped,
+	// so they are averaged over those steps: the total impulse is the same as
+	// at full rate, instead of being multiplied by the number of steps.
+	void Gather(Vector<RigidBody*> const& dynamic_bodies, Uint32 num_substeps, Float32 time_step);
+
+	// Reads velocities and poses from each body's MotionProperties and RigidBody
+	void LoadState();
+
+	// Reads each body's world inertia and inverse inertia, as last computed by
+	// RigidBody::UpdateInternals
+	void LoadInertia();
+
+	// Applies gravity, accumulated forces/torques and damping to velocities.
+	// Forces are consumed by the first call after Gather.
+	void IntegrateForces();
+
+	// Advances positions and orientations by velocities
+	void IntegrateVelocities();
+
+	// Writes velocities back, and clears the bodies' accumulated force and torque
+	void StoreVelocities();
+
+	// Writes position, orientation and their previous values back
+	void StorePoses();
+
+	inline Vector<RigidBody*> const& Bodies() const noexcept { return bodies; }
+	inline Uint32 Size() const noexcept { return static_cast<Uint32>(bodies.size()); }
+
+private:
+	inline Float32* Get(Stream s) noexcept { return data.data() + static_cast<SizeT>(s) * padded_count; }
+};
@@ -4,6 +4,7 @@
 #include "RenderCam.h"
 #include "GraphicsManager.h"
 #include "MotionProperties.h"
+#include "MemoryManager.h"
 
 #define CHECKERROR { \
 GLenum err = glGetError(); \
@@ -144,18 +145,16 @@ void ParticleEmitter::Update(Float32 dt) {
 	// Sort particles based on distance from camera
 	std::sort(particles.begin(), particles.end());
 
-	// Grow GPU data arrays if needed
-	if (colors.size() < particles.size()) {
-		positions_sizes.resize(particles.size());
-		colors.resize(particles.size());
-	}
-
-	// Load particle data into buffers for transmission to the GPU
-	SizeT idx = 0;
+	// Load particle data into buffers for transmission to the GPU. These are
+	// copied by glBufferSubData, so they only need to live for this frame.
+	PolymorphicAllocator frame_alloc = p_memory_manager->GetFrameAllocator();
+	Vector<Vec4> positions_sizes{ frame_alloc };
+	Vector<Vec4> colors{ frame_alloc };
+	positions_sizes.reserve(particles.size());
+	colors.reserve(particles.size());
 	for (auto&& p : particles) {
-		positions_sizes[idx] = Vec4(p.position, p.uniform_scale);
-		colors[idx] = p.color;
-		idx++;
+		positions_sizes.push_back(Vec4(p.position, p.uniform_scale));
+		colors.push_back(p.color);
 	}
 
 	// Send buffers to GPU
@@ -202,6 +201,7 @@ ParticleSystem::~ParticleSystem() noexcept {
 ParticleEmitter* ParticleSystem::NewEmitter() {
 	if (emitters.size() < MAX_EMITTERS) {
 		ParticleEmitter* e = emitters.emplace(quad_vbo);
+		e->handle = emitter_handles.Create(e);
 		sorted_emitters.push_back(e);
 
 		return e;
@@ -215,6 +215,7 @@ void ParticleSystem::EraseEmitter(ParticleEmitter* emitter) {
 		std::find(sorted_emitters.begin(), sorted_emitters.end(), emitter)
 	);
 
+	emitter_handles.Release(emitter->handle);
 	emitters.erase(emitter);
 }
 
@@ -226,6 +227,9 @@ void ParticleSystem::Init() {
 
 void ParticleSystem::Update(Float32 dt) {
 
+	// Release chunks emptied by EraseEmitter since the last update
+	emitters.trim();
+
 	// Update all the emitters
 	for (auto r = emitters.all(); not r.is_empty(); r.pop_front()) {
 		r.front().Update(dt);
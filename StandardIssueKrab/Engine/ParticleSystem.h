@@ -3,7 +3,8 @@
 #include "Bounds.h"
 #include "RandomGenerator.h"
 #include "Texture.h"
-#include "FixedObjectPool.h"
+#include "ChunkedObjectPool.h"
+#include "Handle.h"
 
 // Fwd decls
 class Mesh;
@@ -12,6 +13,8 @@ struct Particle;
 struct ParticleEmitter;
 class ParticleSystem;
 
+using ParticleEmitterHandle = Handle<ParticleEmitter>;
+
 
 struct Particle {
 	Float32 sqr_dist_from_camera = 0.0f;
@@ -41,6 +44,7 @@ struct ParticleEmitter {
 
 	Float32 sqr_dist_from_camera = 0.0f;
 	Vector<Particle> particles;
+	ParticleEmitterHandle handle; // resolve with ParticleSystem::Resolve
 
 	// data used to update and draw particles
 	Bool			 is_active			   = false;
@@ -64,10 +68,6 @@ struct ParticleEmitter {
 	Bounds<Float32> lifetime_secs_gen_bnds = { .min = 0.5f,     .max = 1.0f };
 	Bounds<Float32> uniform_scale_gen_bnds = { .min = 0.5f,     .max = 1.0f };
 
-	// Data for all particles which will be passed to OpenGL
-	Vector<Vec4> positions_sizes{};
-	Vector<Vec4> colors{};
-
 	// OpenGL buffers
 	Uint32 vao = 0;
 	Uint32 positions_sizes_vbo = 0;
@@ -100,9 +100,11 @@ constexpr bool operator<(ParticleEmitter const& l, ParticleEmitter const& r) {
 class ParticleSystem {
 public:
 	static constexpr SizeT MAX_EMITTERS = 2048;
+	static constexpr SizeT EMITTER_CHUNK_SIZE = 64;
 
 private:
-	FixedObjectPool<ParticleEmitter, MAX_EMITTERS> emitters{};
+	ChunkedObjectPool<ParticleEmitter, EMITTER_CHUNK_SIZE> emitters{};
+	HandleTable<ParticleEmitter> emitter_handles{};
 	Vector<ParticleEmitter*> sorted_emitters{};
 
 	Uint32 quad_vbo = 0;
@@ -120,6 +122,11 @@ public:
 	ParticleEmitter* NewEmitter();
 	void EraseEmitter(ParticleEmitter* emitter);
 
+	// Returns the emitter a handle refers to, or nullptr once it was erased
+	inline ParticleEmitter* Resolve(ParticleEmitterHandle handle) const {
+		return emitter_handles.Resolve(handle);
+	}
+
 	// Initializes quad vbo in OpenGL
 	void Init();
 
@@ -131,6 +138,7 @@ public:
 
 	inline void Clear() {
 		sorted_emitters.clear();
+		emitter_handles.Clear();
 		emitters.clear();
 	}
 };
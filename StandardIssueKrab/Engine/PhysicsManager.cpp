@@ -5,22 +5,49 @@
 #include "Transform.h"
 #include "CollisionDebugDrawing.h"
 #include "Mesh.h"
+#include "RenderCam.h"	// used in UpdateSimulationLOD
+#include "MemoryManager.h"	// frame allocator for broadphase results
 
 PhysicsManager::PhysicsManager()
 	: rigidbodies{},
+	rigidbody_handles{},
 	dynamic_bodies{},
 	motion_properties{},
+	motion_batch{},
 	colliders{},
 	bvh_tree{},
 	broad_phase_results{},
 	arbiters{},
+	contact_batch{},
+	narrow_phase_jobs{},
 	debug_wireframes{},
 	cn_plane_mesh{ Collision::WireframeMesh(Collision::Plane{
 		.normal = Vec3(1,0,0),
 		.d = 1
-		}) }
+		}) },
+	lod_settings{},
+	lod_cameras{},
+	force_fields{},
+	stats{},
+	stats_history{}
 {}
 
+PhysicsManager::~PhysicsManager() noexcept {
+	// Colliders are constructed in raw blocks, so destroy them explicitly
+	for (auto r = rigidbodies.all(); not r.is_empty(); r.pop_front()) {
+		RigidBody& rb = r.front();
+		colliders.RemoveBlock(rb.colliders, rb.num_colliders);
+	}
+}
+
+// Returns milliseconds elapsed since start, and resets start to now
+static inline Float32 LapMs(decltype(FrameTimer::Now())& start) {
+	auto const now = FrameTimer::Now();
+	Float32 const ms = FrameTimer::ToSeconds<Float32>(now - start) * 1000.0f;
+	start = now;
+	return ms;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////
 // MANIPULATORS
@@ -31,6 +58,7 @@ RigidBody* PhysicsManager::CreateRigidBody(RigidBodyCreationSettings const& rb_s
 	using Collision::Collider;
 
 	RigidBody& rb = *rigidbodies.insert();
+	rb.handle = rigidbody_handles.Create(&rb);
 
 	// Simple fields
 	rb.position = rb_settings.position;
@@ -41,22 +69,24 @@ RigidBody* PhysicsManager::CreateRigidBody(RigidBodyCreationSettings const& rb_s
 
 	rb.friction = rb_settings.friction;
 	rb.restitution = rb_settings.restitution;
+
+	SIK_ASSERT(rb_settings.layer < 32, "RigidBody layer must be in [0, 31].");
+	rb.layer = rb_settings.layer;
 	
 	// Flags
 	rb.Enable(rb_settings.is_enabled);
 	rb.MakeTrigger(rb_settings.is_trigger);
 	rb.UseBoundingBoxAsCollider(rb_settings.use_aabb_as_collider);
+	rb.MakeFast(rb_settings.is_fast);
 
 	// Colliders
 	Collider* cols[RigidBody::MAX_COLLIDERS] = {};
 	Uint32 count = 0u;
-	for (; count < RigidBody::MAX_COLLIDERS; ++count) {
-
-		ColliderCreationSettings const& col_settings = rb_settings.collider_parameters[count];
-		if (col_settings.type == Collider::Type::NONE) { break; }
-
-		cols[count] = colliders.Add(col_settings, bvh_tree);
+	while (count < RigidBody::MAX_COLLIDERS && 
+		   rb_settings.collider_parameters[count].type != Collider::Type::NONE) {
+		++count;
 	}
+	colliders.AddBlock(rb_settings.collider_parameters, count, cols);
 	rb.AddColliders(cols, count);
 
 	// Collider debug drawing
@@ -131,10 +161,8 @@ RigidBody* PhysicsManager::RemoveRigidBodyInternal(RigidBody* rb) {
 		motion_properties.erase(rb->motion_props);
 	}
 
-	for (auto i = 0u; i < rb->num_colliders; ++i) {
-		// NOTE THAT CONTACT MANIFOLDS ARE NOT CLEANED UP HERE
-		colliders.Remove(rb->colliders[i]);
-	}
+	// NOTE THAT CONTACT MANIFOLDS ARE NOT CLEANED UP HERE
+	colliders.RemoveBlock(rb->colliders, rb->num_colliders);
 
 	// Remove from broad phase
 	auto it = bv_handles.find(rb);
@@ -147,6 +175,7 @@ RigidBody* PhysicsManager::RemoveRigidBodyInternal(RigidBody* rb) {
 		rb->owner->rigidbody = nullptr;
 	}
 
+	rigidbody_handles.Release(rb->handle);
 	return rigidbodies.erase(rb);
 }
 
@@ -188,28 +217,54 @@ RayCastHit PhysicsManager::RayCast(Collision::Ray const& ray)
 	return result;
 }
 
-void PhysicsManager::Update(Float32 time_step) {
+void PhysicsManager::RunQueries(QueryBatch& batch) const {
+	batch.Run(bvh_tree);
+}
+
+void PhysicsManager::Update(Float32 time_step, RenderCam const* view_cam) {
 	using namespace Collision;
 	
 	static constexpr Uint32 numSubsteps = 2;
+	static constexpr Uint32 numSolverIterations = 10;
 
 	Float32 h = time_step / numSubsteps;
 
+	stats = PhysicsStats{};
+	auto const step_start = FrameTimer::Now();
+	auto lap = step_start;
+
 	RemoveTombstoned();
+	stats.tombstone_ms = LapMs(lap);
+
+	UpdateSimulationLOD(time_step, view_cam);
 
-	DetectCollisionsBroad_v2();
+	// Fields go first so impulses are seen by the swept bounds of fast bodies
+	stats.field_bodies = force_fields.Apply(bvh_tree, time_step);
+	stats.integration_ms += LapMs(lap);
 
-	DetectCollisionsNarrow_v2();
+	bvh_tree.ResetNodesVisited();
+	DetectCollisionsBroad_v2(time_step);
+	stats.bvh_nodes_visited = bvh_tree.NodesVisited();
+	stats.broadphase_ms = LapMs(lap);
+
+	DetectCollisionsNarrow_v2(time_step);
+	stats.narrowphase_ms = LapMs(lap);
+
+	// Integration runs over a SoA batch of the bodies stepped this update
+	motion_batch.Gather(dynamic_bodies, numSubsteps, time_step);
+	stats.integration_ms += LapMs(lap);
 
 	// Sim substep loop
 	for (Uint32 i = 0; i < numSubsteps; ++i) {
 
-		for (auto&& dyn : dynamic_bodies) {
-			if (dyn->IsEnabled()) {
-				dyn->IntegrateForces(h);
-				dyn->UpdateInternals();
-			}
+		motion_batch.LoadState();
+		motion_batch.LoadInertia();
+		motion_batch.IntegrateForces();
+		motion_batch.StoreVelocities();
+		for (RigidBody* dyn : motion_batch.Bodies()) {
+			dyn->UpdateInternals();
 		}
+		stats.integration_ms += LapMs(lap);
 
 		if (collisions_active) {
 			for (auto&& [key, arb] : arbiters) {
@@ -218,37 +273,48 @@ void PhysicsManager::Update(Float32 time_step) {
 			// PreStep for constraints
 			// ... joints, etc
 
-			for (auto i = 0; i < 10; ++i) {
+			for (auto i = 0u; i < numSolverIterations; ++i) {
 				for (auto&& [key, arb] : arbiters) {
 					arb.ApplyImpulse();
 				}
 			}
+			stats.solver_iterations += numSolverIterations;
 		}
 
 		// Solve constraints
 		SolveGroundConstraint();
 		// ... joints, etc
+		stats.solver_ms += LapMs(lap);
 
-		for (auto&& dyn : dynamic_bodies) {
-			if (dyn->IsEnabled()) {
-				dyn->IntegrateVelocities(h);
-			}
-		}
+		motion_batch.LoadState();
+		motion_batch.IntegrateVelocities();
+		motion_batch.StorePoses();
+		stats.integration_ms += LapMs(lap);
 	}
 
 	// Collision callbacks - note this might miss some very fast (< 1 frame) collisions
 	// Do we guarantee that all rigidbodies here are valid? I believe so...
 	// Note since this is iterating through ColliderPairs it will call OnCollide
-	// once pair of colliding colliders attached to the rigidbodies
+	// once pair of colliding colliders attached to the rigidbodies.
+	// Speculative contacts are not reported since the bodies never touched.
 	if (collisions_active) {
 		for (auto&& [p, a] : arbiters) {
-			if (a.manifold.num_contacts > 0) {
+			if (a.manifold.num_contacts > 0 && not a.IsTouching()) {
+				++stats.speculative_contacts;
+			}
+			else if (a.manifold.num_contacts > 0) {
 				SIK_ASSERT(p.a->owner && p.b->owner, "Owning GameObjects must be valid here.");
 				p.a->owner->OnCollide(p.b->owner);
 				p.b->owner->OnCollide(p.a->owner);
+
+				++stats.manifolds;
+				stats.contacts += a.manifold.num_contacts;
 			}
 		}
 	}
+
+	stats.total_ms = FrameTimer::ToSeconds<Float32>(FrameTimer::Now() - step_start) * 1000.0f;
+	stats_history.PushBack(stats);
 }
 
 // Checks for overlapping bounding volumes O(n^2)
@@ -307,10 +373,16 @@ void PhysicsManager::DetectCollisionsBroad() noexcept {
 }
 
 
-void PhysicsManager::DetectCollisionsBroad_v2() noexcept
+void PhysicsManager::DetectCollisionsBroad_v2(Float32 time_step) noexcept
 {
 	using namespace Collision;
 
+	// Only lives until the narrowphase of this step, so take it from the frame
+	// allocator. Reserving the last step's capacity keeps it to one allocation.
+	SizeT const expected_pairs = broad_phase_results.capacity();
+	RebindAllocator(broad_phase_results, p_memory_manager->GetFrameAllocator());
+	broad_phase_results.reserve(expected_pairs);
+
 	// Update AABBs and the BVH -- do this for all bodies since 
 	// static bodies might have been moved by the user
 	for (auto r = rigidbodies.all(); not r.is_empty(); r.pop_front()) {
@@ -331,7 +403,14 @@ void PhysicsManager::DetectCollisionsBroad_v2() noexcept
 		}
 		else {
 			// Compute swept bounding box from prev time step to now    
-			AABB const projectedBounds = rb.bounds.Union(preBounds);
+			AABB projectedBounds = rb.bounds.Union(preBounds);
+
+			// Fast bodies also sweep ahead to where they will be at the end of this
+			// step, so that pairs they could tunnel through reach the narrow phase
+			if (rb.IsFast() && rb.motion_props) {
+				Vec3 const ahead = rb.motion_props->linear_velocity * time_step;
+				projectedBounds = projectedBounds.Union(rb.bounds.MovedBy(ahead));
+			}
 
 			Vec3 const disp = rb.bounds.position - preBounds.position;
 			BVHandle const handle = it->second;
@@ -345,6 +424,8 @@ void PhysicsManager::DetectCollisionsBroad_v2() noexcept
 		}
 	}
 
+	stats.moved_bodies = static_cast<Uint32>(moved_last_frame.size());
+
 	// Collect pairs of potentially colliding RigidBodies
 	for (auto&& [query_rb, query_handle] : moved_last_frame) {
 
@@ -410,15 +491,34 @@ void PhysicsManager::DetectCollisionsNarrow() noexcept {
 	}
 }
 
-void PhysicsManager::DetectCollisionsNarrow_v2() noexcept {
+void PhysicsManager::DetectCollisionsNarrow_v2(Float32 time_step) noexcept {
 	using namespace Collision;
 
+	// Pairs are queued first, then collided together so pairs of the same
+	// shape types run through the batched kernels
+	contact_batch.Clear();
+	narrow_phase_jobs.clear();
+
+	auto queue = [this](CollisionArbiter& arb, Bool is_new) {
+		ColliderPair const& p = arb.pair;
+		Uint32 const result_idx = CollisionArbiter::UsesColliders(p)
+			? contact_batch.Add(p.a->colliders[p.idx_a], p.b->colliders[p.idx_b])
+			: NarrowPhaseJob::NO_RESULT;
+		narrow_phase_jobs.push_back(NarrowPhaseJob{ &arb, result_idx, is_new });
+	};
+
 	// Remove existing arbiters which fail to collide in broad phase,
 	// and update the ones which do
 	for (auto it = arbiters.begin(); it != arbiters.end();) {
 		// Decompose into key (ColliderPair) and value (Arbiter)
 		auto& [p, a] = *it;
 
+		// Neither body has moved since the last step, so the manifold still holds
+		if (not p.a->IsSteppedThisUpdate() && not p.b->IsSteppedThisUpdate()) {
+			++it;
+			continue;
+		}
+
 		BVHandle const handleA = bv_handles.at(p.a);
 		BVHandle const handleB = bv_handles.at(p.b);
 
@@ -431,8 +531,7 @@ void PhysicsManager::DetectCollisionsNarrow_v2() noexcept {
 		}
 		else {
 			// Update the arbiter with narrow phase collision detection
-			CollisionArbiter const new_arb{ p };
-			a.Update(new_arb.manifold);
+			queue(a, false);
 			++it;
 		}
 	}
@@ -444,18 +543,35 @@ void PhysicsManager::DetectCollisionsNarrow_v2() noexcept {
 		if (p.a->IsStatic() && p.b->IsStatic()) { continue; }
 
 		// If an arbiter does not exist, add it
-		auto it = arbiters.find(p);
-		if (it == arbiters.end()) {
-			CollisionArbiter const new_arb{ p };
-			arbiters.insert({ p, new_arb });
+		auto [it, inserted] = arbiters.try_emplace(p, p, ContactManifold{});
+		if (inserted) {
+			queue(it->second, true);
 		}
 
 		// Else: the arbiter already exists and we updated it
 		// already, so do nothing
 	}
 
+	contact_batch.Run();
+
+	for (NarrowPhaseJob const& job : narrow_phase_jobs) {
+		ColliderPair const& p = job.arbiter->pair;
+		CollisionArbiter new_arb{ p, job.result_idx == NarrowPhaseJob::NO_RESULT
+			? CollisionArbiter::Collide(p)
+			: contact_batch.Result(job.result_idx) };
+		new_arb.Speculate(time_step);
+
+		if (job.is_new) {
+			job.arbiter->manifold = new_arb.manifold;
+		}
+		else {
+			job.arbiter->Update(new_arb.manifold);
+		}
+	}
+
 	// Now that we've added all broad phase results to narrow phase
 	// we can clear these so future substeps don't reiterate this
+	stats.candidate_pairs = static_cast<Uint32>(broad_phase_results.size());
 	broad_phase_results.clear();
 }
 
@@ -475,22 +591,102 @@ void PhysicsManager::SolveGroundConstraint() noexcept {
 	}
 }
 
+void PhysicsManager::UpdateSimulationLOD(Float32 time_step, RenderCam const* view_cam) noexcept {
+	using SimLOD = RigidBody::SimLOD;
+
+	// Without a camera there is nothing to measure from, so everything runs at full rate
+	Bool const use_lod = lod_settings.enabled && (view_cam != nullptr || not lod_cameras.empty());
+
+	// Squared distances past which a body drops to the next LOD
+	Float32 const thresholds[] = {
+		lod_settings.half_rate_distance * lod_settings.half_rate_distance,
+		lod_settings.quarter_rate_distance * lod_settings.quarter_rate_distance,
+		lod_settings.frozen_distance * lod_settings.frozen_distance
+	};
+	Float32 const promote_scale = (1.0f - lod_settings.hysteresis) * (1.0f - lod_settings.hysteresis);
+
+	for (Uint32 i = 0; i < dynamic_bodies.size(); ++i) {
+		RigidBody* dyn = dynamic_bodies[i];
+
+		SimLOD lod = SimLOD::Full;
+		if (use_lod) {
+			Float32 dist2 = view_cam
+				? glm::distance2(view_cam->GetPosition(), dyn->position)
+				: std::numeric_limits<Float32>::max();
+			for (RenderCam const* cam : lod_cameras) {
+				dist2 = glm::min(dist2, glm::distance2(cam->GetPosition(), dyn->position));
+			}
+
+			// Thresholds the body is already past must be crossed by a margin 
+			// to promote it again, so bodies near a boundary don't flicker
+			Uint32 const curr = static_cast<Uint32>(dyn->sim_lod);
+			Uint32 tier = 0;
+			for (Uint32 t = 0; t < std::size(thresholds); ++t) {
+				Float32 const threshold = t < curr ? thresholds[t] * promote_scale : thresholds[t];
+				if (dist2 > threshold) { tier = t + 1; }
+			}
+			lod = static_cast<SimLOD>(tier);
+		}
+
+		// Frozen bodies don't accumulate time, so they pick up where they left
+		// off. Forces on them are dropped the same way, instead of building up
+		// until the body wakes and jumps.
+		if (lod == SimLOD::Frozen) {
+			dyn->sim_lod = lod;
+			dyn->lod_pending_dt = 0.0f;
+			dyn->lod_step_dt = 0.0f;
+			if (dyn->motion_props) {
+				dyn->motion_props->accumulated_force = Vec3(0);
+				dyn->motion_props->accumulated_torque = Vec3(0);
+			}
+			++stats.skipped_bodies;
+			++stats.frozen_bodies;
+			continue;
+		}
+
+		Uint32 const period = 1u << static_cast<Uint32>(lod);
+
+		// When dropping to a reduced rate, stagger bodies across the period so
+		// they don't all step on the same frame
+		if (lod != dyn->sim_lod && lod != SimLOD::Full && dyn->sim_lod == SimLOD::Full) {
+			dyn->lod_pending_dt = static_cast<Float32>(i % period) * time_step;
+		}
+		dyn->sim_lod = lod;
+
+		// Step once a full period of time has built up. Skipped time is 
+		// integrated in one go, and Extrapolate covers it for rendering.
+		dyn->lod_pending_dt += time_step;
+		if (dyn->lod_pending_dt >= (static_cast<Float32>(period) - 0.5f) * time_step) {
+			dyn->lod_step_dt = dyn->lod_pending_dt;
+			dyn->lod_pending_dt = 0.0f;
+		}
+		else {
+			dyn->lod_step_dt = 0.0f;
+			++stats.skipped_bodies;
+		}
+	}
+}
+
 void PhysicsManager::Clear() noexcept {
 	broad_phase_results.clear();
 	moved_last_frame.clear();
 	bvh_tree.Clear();
 	bv_handles.clear();
 	arbiters.clear();
-	colliders.Clear();
 	motion_properties.clear();
 	dynamic_bodies.clear();
+	force_fields.Clear();
 
 	for (auto r = rigidbodies.all(); not r.is_empty(); r.pop_front()) {
-		if (GameObject* owner = r.front().owner; owner != nullptr) {
+		RigidBody& rb = r.front();
+		colliders.RemoveBlock(rb.colliders, rb.num_colliders);
+
+		if (GameObject* owner = rb.owner; owner != nullptr) {
 			owner->rigidbody = nullptr;
 		}
 	}
 
+	rigidbody_handles.Clear();
 	rigidbodies.clear();
 
 	// Debug
@@ -552,14 +748,45 @@ void PhysicsManager::RemoveTombstoned() noexcept {
 		}
 	}
 
+	rigidbodies.trim();
+	motion_properties.trim();
 }
 
 
+void PhysicsManager::AddLODCamera(RenderCam const* cam) {
+	if (std::find(lod_cameras.begin(), lod_cameras.end(), cam) == lod_cameras.end()) {
+		lod_cameras.push_back(cam);
+	}
+}
+
+void PhysicsManager::RemoveLODCamera(RenderCam const* cam) {
+	std::erase(lod_cameras, cam);
+}
+
 void PhysicsManager::ToggleCollisions() {
 	collisions_active = !collisions_active;
 	MotionProperties::gravity = Vec3(0, static_cast<Float32>(collisions_active) * -9.8f, 0);
 }
 
+Bool PhysicsManager::DumpStatsCSV(const char* filepath) const {
+	std::ofstream file{ filepath };
+	if (not file) {
+		SIK_ERROR("Failed to open \"{}\". Physics stats not written.", filepath);
+		return false;
+	}
+
+	PhysicsStats::WriteCSVHeader(file);
+
+	Uint64 const count = stats_history.Count();
+	Uint64 const first = count > STATS_HISTORY_LENGTH ? count - STATS_HISTORY_LENGTH : 0;
+	for (Uint64 i = first; i < count; ++i) {
+		stats_history[i].WriteCSVRow(file, i);
+	}
+
+	SIK_INFO("Wrote {} steps of physics stats to \"{}\"", count - first, filepath);
+	return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 // ACCESSORS
 ////////////////////////////////////////////////////////////////////////////
@@ -567,7 +794,11 @@ void PhysicsManager::ToggleCollisions() {
 void PhysicsManager::Extrapolate(Float32 extrapolation) noexcept {
 
 	for (auto r = rigidbodies.all(); not r.is_empty(); r.pop_front()) {
-		r.front().SyncWithOwnerTransform(extrapolation, false);
+		RigidBody& rb = r.front();
+
+		// Bodies at a reduced simulation LOD are also behind by the steps they skipped
+		Float32 const t = rb.sim_lod == RigidBody::SimLOD::Frozen ? 0.0f : extrapolation + rb.lod_pending_dt;
+		rb.SyncWithOwnerTransform(t, false);
 	}
 
 }
@@ -598,7 +829,6 @@ Mat3 ArbitraryRotation(Vec3 v, bool IsInverse) {
 
 // TODO : remove when we are able to
 #include "BoxGeometry.h"
-#include "RenderCam.h"
 
 
 static void DrawContactManifold(Collision::ContactManifold const& manifold,
@@ -1,11 +1,18 @@
 #pragma once
 
-#include "FixedObjectPool.h"
+#include "ChunkedObjectPool.h"
+#include "MemoryResources.h"
 #include "Collision.h"
 #include "CollisionArbiter.h"
+#include "ContactBatch.h"
+#include "ForceGenerators.h"
+#include "QueryBatch.h"
 #include "MotionProperties.h"
+#include "MotionBatch.h"
 #include "RigidBody.h"
 #include "BVHierarchy.h"
+#include "PhysicsStats.h"
+#include "RingBuffer.h"
 
 #include "FrameTimer.h"
 
@@ -29,8 +36,8 @@ template<class Fn>
 concept RigidBodyQuery = std::predicate<Fn, RigidBody&>;
 
 
-// Note: because of the large internal buffer, this class should always be
-// allocated on the heap.
+// Note: bodies, motion properties and colliders are stored in chunks which are
+// allocated as they are needed, so there is no cap on the number of bodies.
 
 class PhysicsManager
 {
@@ -38,86 +45,142 @@ class PhysicsManager
 	// TYPES
 	////////////////////////////////////////////////////////////////////////////
 public:
-	static constexpr SizeT MAX_BODIES = 4096;
+	static constexpr SizeT POOL_CHUNK_SIZE = 256;
+	static constexpr SizeT STATS_HISTORY_LENGTH = 600; // ~10s of fixed steps at 60Hz
 
 	template<class T>
-	using Pool = FixedObjectPool<T, MAX_BODIES>;
+	using Pool = ChunkedObjectPool<T, POOL_CHUNK_SIZE>;
+
+	// Distances from the nearest LOD camera at which dynamic bodies drop to a
+	// lower simulation rate. Bodies must come back within 
+	// (1 - hysteresis) * distance to be promoted again.
+	struct SimLODSettings {
+		Float32 half_rate_distance    = 60.0f;
+		Float32 quarter_rate_distance = 120.0f;
+		Float32 frozen_distance       = 200.0f;
+		Float32 hysteresis            = 0.1f;
+		Bool    enabled               = true;
+	};
+
+	// Each RigidBody's colliders are constructed back-to-back in a single block,
+	// so walking a body's colliders touches one contiguous piece of memory.
+	// Blocks are sized by their contents and come from a pool resource.
+	struct ColliderStorage {
+		static constexpr SizeT SLOT_ALIGN = std::max({ 
+			alignof(Collision::Sphere), alignof(Collision::Capsule), alignof(Collision::Hull) });
 
-	struct ColliderPools {
-		Pool<Collision::Sphere> spheres;
-		Pool<Collision::Capsule> capsules;
-		Pool<Collision::Hull>  hulls;
+		PoolMemoryResource memory{ 
+			PoolMemoryResource::Opts{ .largest_required_pool_block = 4096ull },
+			std::pmr::get_default_resource() 
+		};
 
-		inline Collision::Collider* Add(ColliderCreationSettings const& params, Collision::BVHierarchy& tree) {
+		// Bytes a collider of type t occupies in a block
+		static constexpr SizeT SlotSize(Collision::Collider::Type t) {
 			using Collision::Collider;
 
+			SizeT size = 0;
+			switch (t) {
+			break; case Collider::Type::Sphere:  { size = sizeof(Collision::Sphere); }
+			break; case Collider::Type::Capsule: { size = sizeof(Collision::Capsule); }
+			break; case Collider::Type::Hull:	 { size = sizeof(Collision::Hull); }
+			break; default: {}
+			}
+			return (size + SLOT_ALIGN - 1) / SLOT_ALIGN * SLOT_ALIGN;
+		}
+
+		// Constructs count colliders contiguously and writes their addresses to
+		// out_colliders. Does not allocate if count is 0.
+		inline void AddBlock(ColliderCreationSettings const params[], Uint32 count, Collision::Collider* out_colliders[]) {
+			SizeT bytes = 0;
+			for (Uint32 i = 0; i < count; ++i) {
+				bytes += SlotSize(params[i].type);
+			}
+			if (bytes == 0) { return; }
+
+			std::byte* slot = static_cast<std::byte*>(memory.allocate(bytes, SLOT_ALIGN));
+			for (Uint32 i = 0; i < count; ++i) {
+				out_colliders[i] = Construct(params[i], slot);
+				slot += SlotSize(params[i].type);
+			}
+		}
+
+		// Destroys colliders created by a single call to AddBlock and frees their block
+		inline void RemoveBlock(Collision::Collider* const colliders[], Uint32 count) {
+			using Collision::Collider;
+
+			if (count == 0) { return; }
+
+			SizeT bytes = 0;
+			for (Uint32 i = 0; i < count; ++i) {
+				Collider* c = colliders[i];
+				bytes += SlotSize(c->GetType());
+
+				switch (c->GetType()) {
+				break; case Collider::Type::Sphere:  { std::destroy_at(static_cast<Collision::Sphere*>(c)); }
+				break; case Collider::Type::Capsule: { std::destroy_at(static_cast<Collision::Capsule*>(c)); }
+				break; case Collider::Type::Hull:	 { std::destroy_at(static_cast<Collision::Hull*>(c)); }
+				break; default: {
+					SIK_ASSERT(false, "Invalid Collidable type.");
+				}
+				}
+			}
+
+			// The first collider is at the start of the block
+			memory.deallocate(colliders[0], bytes, SLOT_ALIGN);
+		}
+
+	private:
+		static inline Collision::Collider* Construct(ColliderCreationSettings const& params, void* where) {
+			using Collider = Collision::Collider;
+
 			Collision::Collider* col = nullptr;
 
 			switch (params.type) {
 
 			break; case Collider::Type::Sphere: {
-				auto* s = spheres.insert();
+				auto* s = std::construct_at(static_cast<Collision::Sphere*>(where));
 				s->mass = params.mass;
 				s->SetRadius(params.sphere_args.radius);
-				s->SetRelativePosition(params.position_offset);
-				s->SetRelativeRotation(glm::toMat3(params.orientation_offset));
 				col = s;
 			}
 			break; case Collider::Type::Capsule: {
-				auto* c = capsules.insert();
+				auto* c = std::construct_at(static_cast<Collision::Capsule*>(where));
 				c->mass = params.mass;
 				c->SetRadius(params.capsule_args.radius);
 				c->SetLength(params.capsule_args.length);
-				c->SetRelativePosition(params.position_offset);
-				c->SetRelativeRotation(glm::toMat3(params.orientation_offset));
 				col = c;
 			}
 			break; case Collider::Type::Hull: {
 				Collision::Hull* h = nullptr;
 				if (params.hull_args.is_box) {
-					h = hulls.insert(Collision::Hull::BoxInstance(params.hull_args.halfwidths));
+					h = std::construct_at(static_cast<Collision::Hull*>(where), Collision::Hull::BoxInstance(params.hull_args.halfwidths));
 				}
 				else {
-					h = hulls.insert();
+					h = std::construct_at(static_cast<Collision::Hull*>(where));
 				}
 				h->mass = params.mass;
-				h->SetRelativePosition(params.position_offset);
-				h->SetRelativeRotation(glm::toMat3(params.orientation_offset));
 				col = h;
 			}
 			break; default: {
 				SIK_ASSERT(false, "Invalid Collidable type.");
+				return nullptr;
 			}
 			}
 
+			col->SetRelativePosition(params.position_offset);
+			col->SetRelativeRotation(glm::toMat3(params.orientation_offset));
 			return col;
 		}
+	};
 
-		inline void Remove(Collision::Collider* p_shape) {
-			using Collision::Collider;
-
-			switch (p_shape->GetType()) {
+	// A pair waiting on the batched narrow phase. New arbiters are inserted
+	// with an empty manifold and filled in once the batch has run.
+	struct NarrowPhaseJob {
+		CollisionArbiter* arbiter;
+		Uint32			  result_idx; // into contact_batch, NO_RESULT if not batched
+		Bool			  is_new;
 
-			break; case Collider::Type::Sphere: {
-				spheres.erase(static_cast<Collision::Sphere*>(p_shape));
-			}
-			break; case Collider::Type::Capsule: {
-				capsules.erase(static_cast<Collision::Capsule*>(p_shape));
-			}
-			break; case Collider::Type::Hull: {
-				hulls.erase(static_cast<Collision::Hull*>(p_shape));
-			}
-			break; default: {
-				SIK_ASSERT(false, "Invalid Collidable type.");
-			}
-			}
-		}
-
-		void Clear() noexcept {
-			spheres.clear();
-			capsules.clear();
-			hulls.clear();
-		}
+		static constexpr Uint32 NO_RESULT = std::numeric_limits<Uint32>::max();
 	};
 
 private:
@@ -128,6 +191,7 @@ private:
 private:
 	// Storage for rigidbodies
 	Pool<RigidBody>									  rigidbodies;
+	HandleTable<RigidBody>							  rigidbody_handles;
 
 	// Pointers to all active dynamic rigidbodies. These are the only bodies
 	// iterated over during collision detection and resolution.
@@ -136,9 +200,12 @@ private:
 	// Data required to move dynamic bodies
 	Pool<MotionProperties>							  motion_properties;
 
+	// SoA copy of the stepped dynamic bodies' motion state, for batched integration
+	MotionBatch										  motion_batch;
+
 	// All collision primitives used for narrowphase collision detection
-	// and resolution.
-	ColliderPools									  colliders;
+	// and resolution, packed per body.
+	ColliderStorage									  colliders;
 
 	// Dynamic AABB hierarchy and supporting data for broadphase 
 	// collision detection
@@ -149,6 +216,8 @@ private:
 
 	// Narrow phase
 	Map<ColliderPair, CollisionArbiter>				  arbiters;
+	Collision::ContactBatch							  contact_batch;
+	Vector<NarrowPhaseJob>							  narrow_phase_jobs;
 
 	// Debug drawing: stored in order of colliders
 	Vector< std::pair<RigidBody*, Vector<Collision::WireframeMesh>> > debug_wireframes;
@@ -157,12 +226,24 @@ private:
 	// Toggle collisions on/off
 	Bool collisions_active = true;
 
+	// Simulation LOD: dynamic bodies are stepped less often the farther they
+	// are from the view camera passed to Update and every camera in lod_cameras
+	SimLODSettings									  lod_settings;
+	Vector<RenderCam const*>						  lod_cameras;
+
+	// Magnets, explosions, wind etc. Applied at the start of each step.
+	ForceFieldRegistry								  force_fields;
+
+	// Instrumentation: stats for the latest step, plus a short history for dumping
+	PhysicsStats									  stats;
+	RingBuffer<PhysicsStats, STATS_HISTORY_LENGTH>    stats_history;
+
 ////////////////////////////////////////////////////////////////////////////
 // CTORS + DTOR
 ////////////////////////////////////////////////////////////////////////////
 public:
 	PhysicsManager();
-	~PhysicsManager() noexcept = default;
+	~PhysicsManager() noexcept;
 
 	// Non-copyable and non-movable
 	PhysicsManager(const PhysicsManager&) = delete;
@@ -185,7 +266,9 @@ public:
 		FrameTimer::duration_type collision_step_time,
 		Uint32 integration_substeps);*/
 
-	void Update(Float32 time_step);
+	// Simulation LOD is measured from view_cam, the camera the game renders
+	// through, and the extra LOD cameras. view_cam may be nullptr.
+	void Update(Float32 time_step, RenderCam const* view_cam);
 
 	// Returns pointer to newly created rigidbody
 	RigidBody* CreateRigidBody(RigidBodyCreationSettings const& settings);
@@ -195,6 +278,12 @@ public:
 	void RemoveRigidBody(RigidBody* rb);
 	RigidBody* RemoveRigidBodyInternal(RigidBody* rb);
 
+	// Returns the rigidbody a handle refers to, or nullptr once it was removed
+	inline RigidBody* Resolve(RigidBodyHandle handle) const {
+		RigidBody* rb = rigidbody_handles.Resolve(handle);
+		return rb && rb->IsValid() ? rb : nullptr;
+	}
+
 	// Returns first game object that the ray intersects with, plus information
 	// about the intersection (i.e. distance from ray origin, etc). Note that
 	// this is not a very granular check! It only checks against AABBs.
@@ -203,11 +292,26 @@ public:
 	void ForEachInRadius(Float32 radius, Vec3 const& center, RigidBodyQuery auto&& function);
 	void ForEachInBox(Collision::AABB const& box,            RigidBodyQuery auto&& function);
 
+	// Runs every query in the batch against the broadphase BVH. Prefer this
+	// over many ForEachInRadius/ForEachInBox calls when lots of objects query
+	// each tick. Must not be called during Update.
+	void RunQueries(QueryBatch& batch) const;
+
 	void Clear() noexcept;
 	void RemoveTombstoned() noexcept;
 
 	void ToggleCollisions();
 
+	// Extra cameras used to pick each dynamic body's simulation LOD, e.g. a
+	// second player's, besides the view camera passed to Update. With no
+	// camera at all every body is simulated at the full rate.
+	void AddLODCamera(RenderCam const* cam);
+	void RemoveLODCamera(RenderCam const* cam);
+
+	// Writes the most recent steps' stats (up to STATS_HISTORY_LENGTH) to a CSV
+	// file. Returns true on success.
+	Bool DumpStatsCSV(const char* filepath) const;
+
 	////////////////////////////////////////////////////////////////////////////
 	// Helpers
 	////////////////////////////////////////////////////////////////////////////
@@ -215,18 +319,24 @@ private:
 	// Checks for overlapping bounding volumes
 	void DetectCollisionsBroad() noexcept;
 
-	void DetectCollisionsBroad_v2() noexcept;
+	// Fast bodies are swept forward by their velocity over time_step
+	void DetectCollisionsBroad_v2(Float32 time_step) noexcept;
 
 	// Checks for actual collision between physics geometries
 	void DetectCollisionsNarrow() noexcept;
 
-	void DetectCollisionsNarrow_v2() noexcept;
+	// Adds speculative contacts for fast bodies which may meet within time_step
+	void DetectCollisionsNarrow_v2(Float32 time_step) noexcept;
 
 	// Resolves collisions and other constraints
 	//void XPBDSolvePositions();
 	//void XPBDSolveVelocities(Float32 h);
 	void SolveGroundConstraint() noexcept;
 
+	// Picks each dynamic body's SimLOD from its distance to the nearest LOD 
+	// camera, and sets how much time it integrates over this step
+	void UpdateSimulationLOD(Float32 time_step, RenderCam const* view_cam) noexcept;
+
 	////////////////////////////////////////////////////////////////////////////
 	// ACCESSORS
 	////////////////////////////////////////////////////////////////////////////
@@ -241,6 +351,16 @@ public:
 	void Extrapolate(Float32 extrapolation) noexcept;	
 	void Interpolate(Float32 interpolation) noexcept;	
 
+	// Timings and counters from the most recent call to Update
+	inline PhysicsStats const& GetStats() const noexcept { return stats; }
+	inline Uint64 GetStepCount() const noexcept { return stats_history.Count(); }
+
+	inline SimLODSettings& GetSimLODSettings() noexcept { return lod_settings; }
+
+	// Add/remove/move force fields here. Fields persist across steps until
+	// removed, cleared, or their duration runs out.
+	inline ForceFieldRegistry& GetForceFields() noexcept { return force_fields; }
+
 	// TODO : temporary. move to the appropriate place when communication between 
 	// physics, graphics, and game objects is worked out
 	void DebugDraw(GLuint shader_id, const RenderCam* cam, Float32 extrapolation, PhysDebugBox const& box) noexcept;
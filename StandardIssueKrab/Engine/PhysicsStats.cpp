@@ -0,0 +1,30 @@
+#include "stdafx.h"
+#include "PhysicsStats.h"
+
+void PhysicsStats::WriteCSVHeader(std::ostream& os) {
+	os << "step,"
+		<< "tombstone_ms,broadphase_ms,narrowphase_ms,solver_ms,integration_ms,total_ms,"
+		<< "moved_bodies,bvh_nodes_visited,candidate_pairs,manifolds,contacts,speculative_contacts,solver_iterations,skipped_bodies,frozen_bodies,field_bodies"
+		<< '\n';
+}
+
+void PhysicsStats::WriteCSVRow(std::ostream& os, Uint64 step_index) const {
+	os << step_index << ','
+		<< tombstone_ms << ','
+		<< broadphase_ms << ','
+		<< narrowphase_ms << ','
+		<< solver_ms << ','
+		<< integration_ms << ','
+		<< total_ms << ','
+		<< moved_bodies << ','
+		<< bvh_nodes_visited << ','
+		<< candidate_pairs << ','
+		<< manifolds << ','
+		<< contacts << ','
+		<< speculative_contacts << ','
+		<< solver_iterations << ','
+		<< skipped_bodies << ','
+		<< frozen_bodies << ','
+		<< field_bodies
+		<< '\n';
+}
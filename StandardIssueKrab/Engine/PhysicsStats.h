@@ -0,0 +1,39 @@
+#pragma once
+
+/*
+* Per-step timings and counters collected by PhysicsManager::Update. Filling
+* this only costs a handful of clock reads and integer increments per step, so
+* it is always on (including release builds).
+*
+* Times are in milliseconds of wall-clock time spent inside each phase of a
+* single fixed step. Counters are totals for that step (summed over substeps
+* where applicable).
+*/
+struct PhysicsStats
+{
+	// Timings (ms)
+	Float32 tombstone_ms   = 0.0f;
+	Float32 broadphase_ms  = 0.0f;
+	Float32 narrowphase_ms = 0.0f;
+	Float32 solver_ms      = 0.0f;
+	Float32 integration_ms = 0.0f;
+	Float32 total_ms       = 0.0f;
+
+	// Counters
+	Uint32  moved_bodies       = 0;
+	Uint32  bvh_nodes_visited  = 0;
+	Uint32  candidate_pairs    = 0;
+	Uint32  manifolds          = 0;
+	Uint32  contacts           = 0;
+	Uint32  speculative_contacts = 0; // manifolds held only by speculative contacts (fast bodies)
+	Uint32  solver_iterations  = 0;
+	Uint32  skipped_bodies     = 0; // dynamic bodies not stepped due to their simulation LOD
+	Uint32  frozen_bodies      = 0;
+	Uint32  field_bodies       = 0; // body-field pairs which received a force or impulse
+
+	// Writes the column names for WriteCSVRow, terminated by a newline
+	static void WriteCSVHeader(std::ostream& os);
+
+	// Writes this step's values as one comma-separated line
+	void WriteCSVRow(std::ostream& os, Uint64 step_index) const;
+};
@@ -0,0 +1,154 @@
+#include "stdafx.h"
+#include "QueryBatch.h"
+
+#include <execution>
+
+#include "RigidBody.h"
+
+// Below this many queries, running them on one thread is cheaper than
+// handing them out to the parallel algorithm
+static constexpr Uint32 PARALLEL_THRESHOLD = 16;
+
+QueryBatch::QueryBatch()
+	: queries{},
+	// Filled concurrently, so use a thread-safe resource rather than the
+	// default one (which may be an untracked debug resource)
+	scratch{ std::pmr::new_delete_resource() },
+	hits{},
+	ranges{}
+{}
+
+Uint32 QueryBatch::AddSphere(Vec3 const& center, Float32 radius, Uint32 layer_mask, Uint32 max_hits) {
+	return Add(Query{
+		.shape = Shape::Sphere,
+		.layer_mask = layer_mask,
+		.max_hits = max_hits,
+		.center = center,
+		.radius = radius
+		});
+}
+
+Uint32 QueryBatch::AddBox(Collision::AABB const& box, Uint32 layer_mask, Uint32 max_hits) {
+	return Add(Query{
+		.shape = Shape::Box,
+		.layer_mask = layer_mask,
+		.max_hits = max_hits,
+		.box = box
+		});
+}
+
+Uint32 QueryBatch::AddRay(Collision::Ray const& ray, Float32 max_distance, Uint32 layer_mask, Uint32 max_hits) {
+	return Add(Query{
+		.shape = Shape::Ray,
+		.layer_mask = layer_mask,
+		.max_hits = max_hits,
+		.ray = ray,
+		.max_distance = max_distance
+		});
+}
+
+Uint32 QueryBatch::Add(Query const& query) {
+	SIK_ASSERT(query.max_hits > 0, "Query would never return anything.");
+	queries.push_back(query);
+	return static_cast<Uint32>(queries.size() - 1);
+}
+
+void QueryBatch::Clear() {
+	queries.clear();
+	hits.clear();
+	ranges.clear();
+}
+
+void QueryBatch::Run(Collision::BVHierarchy const& bvh) {
+	Uint32 const count = Size();
+	if (scratch.size() < count) {
+		scratch.resize(count);
+	}
+
+	if (count < PARALLEL_THRESHOLD) {
+		for (Uint32 i = 0; i < count; ++i) {
+			RunOne(bvh, i);
+		}
+	}
+	else {
+		std::for_each(std::execution::par, queries.begin(), queries.end(), [this, &bvh](Query const& q) {
+			RunOne(bvh, static_cast<Uint32>(&q - queries.data()));
+		});
+	}
+
+	// Compact every query's hits into one array
+	SizeT total = 0;
+	for (Uint32 i = 0; i < count; ++i) {
+		total += scratch[i].size();
+	}
+
+	hits.clear();
+	hits.reserve(total);
+	ranges.resize(count);
+	for (Uint32 i = 0; i < count; ++i) {
+		ranges[i] = Range{
+			.first = static_cast<Uint32>(hits.size()),
+			.count = static_cast<Uint32>(scratch[i].size())
+		};
+		hits.insert(hits.end(), scratch[i].begin(), scratch[i].end());
+	}
+}
+
+void QueryBatch::RunOne(Collision::BVHierarchy const& bvh, Uint32 query_idx) {
+	using namespace Collision;
+
+	Query const& q = queries[query_idx];
+	Vector<Hit>& out = scratch[query_idx];
+	out.clear();
+
+	auto in_layer = [&q](RigidBody const& rb) {
+		return (q.layer_mask & RigidBody::LayerBit(rb.layer)) != 0;
+	};
+
+	switch (q.shape) {
+	break; case Shape::Sphere: {
+		Float32 const r2 = q.radius * q.radius;
+		bvh.Query(q.radius, q.center, [&](BVHNode const& node) {
+			RigidBody* rb = static_cast<RigidBody*>(node.bv.userData);
+			SIK_ASSERT(rb, "RigidBody was nullptr");
+			if (in_layer(*rb) && rb->bounds.DistSquaredFromPoint(q.center) < r2) {
+				out.push_back(Hit{ rb, 0.0f });
+			}
+			return out.size() < q.max_hits;
+		});
+	}
+	break; case Shape::Box: {
+		bvh.Query(q.box, [&](BVHNode const& node) {
+			RigidBody* rb = static_cast<RigidBody*>(node.bv.userData);
+			SIK_ASSERT(rb, "RigidBody was nullptr");
+			if (in_layer(*rb) && rb->bounds.Intersects(q.box)) {
+				out.push_back(Hit{ rb, 0.0f });
+			}
+			return out.size() < q.max_hits;
+		});
+	}
+	break; case Shape::Ray: {
+		// Collect every hit before sorting, so max_hits keeps the closest ones
+		bvh.Query(q.ray, [&](BVHNode const& node, Ray::CastResult const& fat_cast) {
+			if (fat_cast.distance > q.max_distance) { return true; }
+
+			RigidBody* rb = static_cast<RigidBody*>(node.bv.userData);
+			SIK_ASSERT(rb, "RigidBody was nullptr");
+			if (not in_layer(*rb)) { return true; }
+
+			if (Ray::CastResult const cast = q.ray.Cast(rb->bounds); cast.hit && cast.distance <= q.max_distance) {
+				out.push_back(Hit{ rb, cast.distance });
+			}
+			return true;
+		});
+
+		std::sort(out.begin(), out.end(), [](Hit const& a, Hit const& b) { return a.distance < b.distance; });
+		if (out.size() > q.max_hits) {
+			out.resize(q.max_hits);
+		}
+	}
+	break; default: {
+		SIK_ASSERT(false, "Invalid query shape.");
+	}
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "BVHierarchy.h"
+
+#include <span>
+
+struct RigidBody;
+
+/*
+* A batch of spatial queries against the physics BVH. Gameplay code submits
+* many sphere, box and ray queries, the PhysicsManager runs them all at once
+* (in parallel for larger batches), and each query's hits come back as a
+* range into one compact results array.
+*
+* Hits are tested against each body's tight bounds, not just the BVH's fat
+* bounds. Ray hits are sorted closest first. Bodies whose layer is not in a
+* query's layer_mask are skipped during the traversal.
+*
+* Usage:
+*	QueryBatch batch;
+*	Uint32 const aggro = batch.AddSphere(enemy_pos, 20.0f, RigidBody::LayerBit(PLAYER_LAYER));
+*	Uint32 const sight = batch.AddRay(ray, 50.0f);
+*	p_physics_manager->RunQueries(batch);
+*	for (QueryBatch::Hit const& hit : batch.Hits(aggro)) { ... }
+*
+* A batch can be cleared and reused every tick to keep its storage.
+*/
+class QueryBatch
+{
+public:
+	static constexpr Uint32 ALL_LAYERS = ~0u;
+	static constexpr Uint32 NO_LIMIT = ~0u;
+	static constexpr Uint32 NO_QUERY = ~0u; // never returned by Add*, for callers to mark having none
+
+	struct Hit {
+		RigidBody* body;
+		Float32	   distance; // along the ray for ray queries, 0 otherwise
+	};
+
+	// Location of one query's hits in the results array
+	struct Range {
+		Uint32 first = 0;
+		Uint32 count = 0;
+	};
+
+private:
+	enum class Shape : Uint32 { Sphere, Box, Ray };
+
+	struct Query {
+		Shape			shape;
+		Uint32			layer_mask;
+		Uint32			max_hits;
+		Collision::AABB box;		  // Box
+		Vec3			center;		  // Sphere
+		Float32			radius;		  // Sphere
+		Collision::Ray	ray;		  // Ray
+		Float32			max_distance; // Ray
+	};
+
+	Vector<Query>		queries;
+	Vector<Vector<Hit>> scratch; // one per query, so queries can run concurrently
+	Vector<Hit>			hits;
+	Vector<Range>		ranges;
+
+public:
+	QueryBatch();
+
+	// Each returns the query's index, used to read its hits after running
+	Uint32 AddSphere(Vec3 const& center, Float32 radius, Uint32 layer_mask = ALL_LAYERS, Uint32 max_hits = NO_LIMIT);
+	Uint32 AddBox(Collision::AABB const& box, Uint32 layer_mask = ALL_LAYERS, Uint32 max_hits = NO_LIMIT);
+	Uint32 AddRay(Collision::Ray const& ray, Float32 max_distance, Uint32 layer_mask = ALL_LAYERS, Uint32 max_hits = NO_LIMIT);
+
+	// Removes queries and results, keeping storage
+	void Clear();
+
+	// Runs every query. Called through PhysicsManager::RunQueries.
+	void Run(Collision::BVHierarchy const& bvh);
+
+	inline Range GetRange(Uint32 query) const { return ranges[query]; }
+	inline std::span<Hit const> Hits(Uint32 query) const {
+		return std::span<Hit const>(hits.data() + ranges[query].first, ranges[query].count);
+	}
+	inline std::span<Hit const> AllHits() const { return hits; }
+	inline Uint32 Size() const noexcept { return static_cast<Uint32>(queries.size()); }
+
+private:
+	Uint32 Add(Query const& query);
+	void RunOne(Collision::BVHierarchy const& bvh, Uint32 query_idx);
+};
@@ -287,6 +287,8 @@ DEFINE_MEMBER(Float32, mass)
 DEFINE_MEMBER(Bool, is_enabled)
 DEFINE_MEMBER(Bool, is_trigger)
 DEFINE_MEMBER(Bool, use_aabb_as_collider)
+DEFINE_MEMBER(Bool, is_fast)
+DEFINE_MEMBER(Uint32, layer)
 END_ATTRIBUTES
 
 BEGIN_ATTRIBUTES_FOR(RigidBody)
@@ -1,11 +1,14 @@
 #pragma once
 
 #include "Collision.h"
+#include "Handle.h"
 
 class GameObject;
 struct RigidBody;
 struct MotionProperties;
 
+using RigidBodyHandle = Handle<RigidBody>;
+
 
 struct ColliderPair {
 	ColliderPair(RigidBody* a_, Uint32 idx_a_, RigidBody* b_, Uint32 idx_b_);
@@ -32,11 +35,21 @@ public:
 		Kinematic
 	};
 
+	// Simulation level of detail. Bodies far from every camera are stepped
+	// less often (see PhysicsManager::UpdateSimulationLOD)
+	enum class SimLOD : Uint8 {
+		Full,    // every step
+		Half,    // every 2nd step
+		Quarter, // every 4th step
+		Frozen   // not stepped; acts as an immovable body in contacts
+	};
+
 	enum Info {
 		IS_INVALID = 0,
 		IS_AWAKE = 1,
 		IS_TRIGGER = 2,
 		USE_AABB_AS_COLLIDER = 3,
+		IS_FAST = 4, // uses speculative contacts (continuous collision)
 		COUNT
 	};
 
@@ -45,8 +58,12 @@ public:
 	static constexpr Uint32 MAX_COLLIDERS = 6;
 	using CollidersList = Collision::Collider* [MAX_COLLIDERS];
 
+	// Mask bit for a layer, as used by force fields and spatial queries
+	static constexpr Uint32 LayerBit(Uint32 layer) { return 1u << layer; }
+
 	// Connection to the Game World
 	GameObject* owner = nullptr;
+	RigidBodyHandle handle; // resolve with PhysicsManager::Resolve
 
 	// Flags
 	MotionType           motion_type = MotionType::Static;
@@ -65,6 +82,12 @@ public:
 	Uint32				 num_colliders = 0;
 	Float32				 friction = 0.0f;     // 0 --> frictionless
 	Float32				 restitution = 1.0f;  // this does not work yet! 0 --> fully inelastic, 1 --> fully elastic
+	Uint32				 layer = 0;           // 0-31, used to filter force fields and spatial queries (see LayerBit)
+
+	// Simulation LOD
+	SimLOD				 sim_lod = SimLOD::Full;
+	Float32				 lod_pending_dt = 0.0f; // sim time skipped since this body was last stepped
+	Float32				 lod_step_dt = 0.0f;    // sim time to integrate over this step, 0 if skipped
 
 
 public:
@@ -78,6 +101,7 @@ public:
 	inline void		  MakeTrigger(Bool val = true);
 	inline void		  MakeInvalid();
 	inline void		  UseBoundingBoxAsCollider(Bool val = true);
+	inline void		  MakeFast(Bool val = true);
 
 	// Accessors
 	inline Bool       IsStatic() const;
@@ -87,6 +111,8 @@ public:
 	inline Bool       IsEnabled() const;
 	inline Bool       IsTrigger() const;
 	inline Bool		  IsBoundingBoxUsedAsCollider() const;
+	inline Bool		  IsFast() const;
+	inline Bool		  IsSteppedThisUpdate() const;
 	inline MotionType GetMotionType() const;
 	// inline AABB       GetBoundingBox() const; // applies transform to bounds
 
@@ -153,6 +179,8 @@ struct RigidBodyCreationSettings {
 	Bool					  is_enabled = true;
 	Bool					  is_trigger = false;
 	Bool					  use_aabb_as_collider = false;
+	Bool					  is_fast = false; // sweep bounds and add speculative contacts
+	Uint32					  layer = 0;	   // 0-31, used to filter spatial queries
 };
 
 #include "RigidBody.inl"
\ No newline at end of file
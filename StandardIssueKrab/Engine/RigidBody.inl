@@ -24,6 +24,11 @@ inline void RigidBody::UseBoundingBoxAsCollider(Bool val) {
 	else	 { info.reset(USE_AABB_AS_COLLIDER); }
 }
 
+inline void RigidBody::MakeFast(Bool val) {
+	if (val) { info.set(IS_FAST); }
+	else	 { info.reset(IS_FAST); }
+}
+
 inline void RigidBody::MakeInvalid() {
 	info.set(IS_INVALID);
 }
@@ -76,6 +81,15 @@ inline Bool RigidBody::IsBoundingBoxUsedAsCollider() const {
 	return info.test(USE_AABB_AS_COLLIDER);
 }
 
+inline Bool RigidBody::IsFast() const {
+	return info.test(IS_FAST);
+}
+
+// Kinematic bodies are moved by game code every update, and never skipped
+inline Bool RigidBody::IsSteppedThisUpdate() const {
+	return IsKinematic() || lod_step_dt > 0.0f;
+}
+
 inline RigidBody::MotionType RigidBody::GetMotionType() const {
 	return motion_type;
 }
\ No newline at end of file
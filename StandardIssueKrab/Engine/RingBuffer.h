@@ -28,6 +28,12 @@ public:
 	// Non-throwing checked access
 	T* TryAt(std::size_t idx) noexcept;
 	T const* TryAt(std::size_t idx) const noexcept;
+
+	// Returns: total number of elements ever pushed (index of the next element)
+	std::size_t Count() const noexcept { return count_; }
+
+	// Returns: max number of elements which can be held before overwriting
+	static constexpr std::size_t Capacity() noexcept { return N; }
 };
 
 template<class T, std::size_t N>
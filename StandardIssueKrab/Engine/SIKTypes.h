@@ -94,6 +94,9 @@ using Map = std::pmr::map<Key, T, Compare>;
 template<class Key, class T, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>>
 using UnorderedMap = std::pmr::unordered_map<Key, T, Hash, Pred>;
 
+template<class Key, class T, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>>
+using UnorderedMultiMap = std::pmr::unordered_multimap<Key, T, Hash, Pred>;
+
 template<class Key, class Compare = std::less<Key>>
 using Set = std::pmr::set<Key, Compare>;
 
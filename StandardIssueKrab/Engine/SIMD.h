@@ -0,0 +1,48 @@
+#pragma once
+
+#include <emmintrin.h>
+
+/*
+* Thin wrappers over 4-wide SSE float math, shared by the batched physics
+* kernels (MotionBatch, ContactBatch). Loads and stores are unaligned since
+* the SoA streams are plain Vectors.
+*/
+namespace SIMD {
+
+	using F4 = __m128;
+
+	static constexpr Uint32 WIDTH = 4;
+
+	inline F4 Load(Float32 const* p)	   { return _mm_loadu_ps(p); }
+	inline void Store(Float32* p, F4 v) { _mm_storeu_ps(p, v); }
+	inline F4 Splat(Float32 x)		   { return _mm_set1_ps(x); }
+	inline F4 Zero()					   { return _mm_setzero_ps(); }
+	inline F4 AllTrue()				   { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+
+	inline F4 Add(F4 a, F4 b)  { return _mm_add_ps(a, b); }
+	inline F4 Sub(F4 a, F4 b)  { return _mm_sub_ps(a, b); }
+	inline F4 Mul(F4 a, F4 b)  { return _mm_mul_ps(a, b); }
+	inline F4 Div(F4 a, F4 b)  { return _mm_div_ps(a, b); }
+	inline F4 Sqrt(F4 v)	   { return _mm_sqrt_ps(v); }
+	inline F4 Abs(F4 v)		   { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+	inline F4 Clamp01(F4 v)	   { return _mm_min_ps(_mm_max_ps(v, Zero()), Splat(1.0f)); }
+
+	// Comparisons return lane masks (all bits set where true)
+	inline F4 Less(F4 a, F4 b)		{ return _mm_cmplt_ps(a, b); }
+	inline F4 LessEqual(F4 a, F4 b) { return _mm_cmple_ps(a, b); }
+	inline F4 Greater(F4 a, F4 b)	{ return _mm_cmpgt_ps(a, b); }
+	inline F4 GreaterEqual(F4 a, F4 b) { return _mm_cmpge_ps(a, b); }
+	inline F4 NotEqual(F4 a, F4 b)	{ return _mm_cmpneq_ps(a, b); }
+	inline F4 And(F4 a, F4 b)		{ return _mm_and_ps(a, b); }
+	inline F4 Or(F4 a, F4 b)		{ return _mm_or_ps(a, b); }
+
+	// Lane-wise mask ? a : b
+	inline F4 Select(F4 mask, F4 a, F4 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+	// Bit i is set if lane i of the mask is true
+	inline Uint32 MoveMask(F4 mask) { return static_cast<Uint32>(_mm_movemask_ps(mask)); }
+
+	inline F4 Dot(F4 const a[3], F4 const b[3]) {
+		return Add(Add(Mul(a[0], b[0]), Mul(a[1], b[1])), Mul(a[2], b[2]));
+	}
+}
@@ -49,6 +49,9 @@ void ScriptingManager::DeleteBehaviour(Behaviour* p_behaviour) {
 		p_behaviour->owner_gui->SetBehaviour(nullptr);
 
 	script_pool.erase(p_behaviour);
+
+	// Behaviours are iterated through behaviours_list, never through the pool
+	script_pool.trim();
 }
 
 /*
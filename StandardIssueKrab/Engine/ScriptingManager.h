@@ -3,7 +3,7 @@
 #include <lua.hpp>
 #include <sol/sol.hpp>
 
-#include "FixedObjectPool.h"
+#include "ChunkedObjectPool.h"
 #include "Behaviour.h"
 
 // forward decls
@@ -48,7 +48,7 @@ public:
 	*/
 	Vector<Behaviour*>& GetBehaviorListRef();
 private:
-	FixedObjectPool<Behaviour, 2048> script_pool;
+	ChunkedObjectPool<Behaviour, 128> script_pool;
 	Vector<Behaviour*> behaviours_list;
 private:
 	void RegisterActionsEnum(sol::state& state) const;
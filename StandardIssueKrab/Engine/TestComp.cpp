@@ -1,6 +1,8 @@
 #include "stdafx.h"
 
 #include "GameObject.h"
+#include "GameObjectManager.h"
+#include "MemoryResources.h"
 #include "TestComp.h"
 
 BEGIN_ATTRIBUTES_FOR(TestComp)
@@ -30,4 +32,36 @@ void TestComp2::OnCollide(GameObject* other) {
 }
 
 BEGIN_ATTRIBUTES_FOR(TestComp2)
+END_ATTRIBUTES
+
+
+void TestUpdateRecord::Record() {
+	order = test_update_counter++;
+	++updates;
+	in_parallel_job = ParallelJobScope::Active();
+	thread = std::this_thread::get_id();
+}
+
+void TestWriterComp::Update(Float32 dt) {
+	record.Record();
+}
+
+BEGIN_ATTRIBUTES_FOR(TestWriterComp)
+END_ATTRIBUTES
+
+
+void TestReaderComp::Update(Float32 dt) {
+	record.Record();
+	p_game_obj_manager->Defer([this] { deferred_order = test_update_counter++; });
+}
+
+BEGIN_ATTRIBUTES_FOR(TestReaderComp)
+END_ATTRIBUTES
+
+
+void TestMainThreadComp::Update(Float32 dt) {
+	record.Record();
+}
+
+BEGIN_ATTRIBUTES_FOR(TestMainThreadComp)
 END_ATTRIBUTES
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include "Serializer.h"
 #include "Component.h"
 
+#include <atomic>
+#include <thread>
+
 class TestComp : public Component {
 public:
 	VALID_COMPONENT(TestComp);
@@ -40,4 +43,58 @@ public:
 
 private:
 	Vector<Uint32> vec;
+};
+
+// When and where a test component last updated, for checking the component
+// storage's batches. Orders come from test_update_counter.
+struct TestUpdateRecord {
+	Uint32 order = ~0u;
+	Uint32 updates = 0;
+	Bool in_parallel_job = false;
+	std::thread::id thread{};
+
+	void Record();
+};
+inline std::atomic<Uint32> test_update_counter{ 0 };
+
+// Writes its owner's Transform, so it can update in parallel
+class TestWriterComp : public Component {
+public:
+	VALID_COMPONENT(TestWriterComp);
+	static constexpr Uint16 access = ACCESS_READ_TRANSFORM | ACCESS_WRITE_TRANSFORM;
+	ALLOW_PRIVATE_REFLECTION;
+	DEFAULT_SERIALIZE(TestWriterComp);
+
+	void Update(Float32 dt) override;
+
+	TestUpdateRecord record;
+};
+
+// Reads other objects' Transforms, so it cannot share a batch with
+// TestWriterComp. Defers a command from every update.
+class TestReaderComp : public Component {
+public:
+	VALID_COMPONENT(TestReaderComp);
+	static constexpr Uint16 access = ACCESS_READ_OTHER_TRANSFORMS;
+	ALLOW_PRIVATE_REFLECTION;
+	DEFAULT_SERIALIZE(TestReaderComp);
+
+	void Update(Float32 dt) override;
+
+	TestUpdateRecord record;
+	Uint32 deferred_order = ~0u;
+};
+
+// Writes its owner's Transform and reads other objects', so it updates on
+// the main thread
+class TestMainThreadComp : public Component {
+public:
+	VALID_COMPONENT(TestMainThreadComp);
+	static constexpr Uint16 access = ACCESS_READ_TRANSFORM | ACCESS_WRITE_TRANSFORM | ACCESS_READ_OTHER_TRANSFORMS;
+	ALLOW_PRIVATE_REFLECTION;
+	DEFAULT_SERIALIZE(TestMainThreadComp);
+
+	void Update(Float32 dt) override;
+
+	TestUpdateRecord record;
 };
\ No newline at end of file
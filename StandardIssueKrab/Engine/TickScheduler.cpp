@@ -0,0 +1,127 @@
+#include "stdafx.h"
+#include "TickScheduler.h"
+
+#include "GameObject.h"
+#include "GraphicsManager.h"
+#include "RenderCam.h"
+
+// Spreads consecutive handle indices evenly over [0, 1)
+static constexpr Float64 GOLDEN_RATIO_FRACTION = 0.6180339887498949;
+
+static Float64 PhaseOf(GameObject* obj) noexcept {
+	if (obj == nullptr) { return 0.0; }
+
+	Float64 const phase = static_cast<Float64>(obj->GetHandle().info.index) * GOLDEN_RATIO_FRACTION;
+	return phase - std::floor(phase);
+}
+
+// Default and Effects update every frame until configured. AI and Ambient 
+// drop their rate when nobody can see them.
+TickScheduler::TickScheduler()
+	: groups{ {
+		GroupSettings{},																// Default
+		GroupSettings{ .rate = EVERY_FRAME, .lod_rate = 10.0f, .lod_distance = 0.0f },	// AI
+		GroupSettings{},																// Effects
+		GroupSettings{ .rate = 20.0f, .lod_rate = 5.0f, .lod_distance = 0.0f }			// Ambient
+	} },
+	lod_cameras{},
+	lod_views{}
+{
+}
+
+void TickScheduler::SetGroupSettings(Component::TickGroup group, GroupSettings const& settings) noexcept {
+	SIK_ASSERT(settings.rate >= 0.0f && settings.lod_rate >= 0.0f, "Tick rates must not be negative.");
+	groups[static_cast<SizeT>(group)] = settings;
+}
+
+TickScheduler::GroupSettings const& TickScheduler::GetGroupSettings(Component::TickGroup group) const noexcept {
+	return groups[static_cast<SizeT>(group)];
+}
+
+void TickScheduler::AddLODCamera(RenderCam const* cam) {
+	if (std::find(lod_cameras.begin(), lod_cameras.end(), cam) == lod_cameras.end()) {
+		lod_cameras.push_back(cam);
+		lod_views.reserve(lod_cameras.size() + 1);
+	}
+}
+
+void TickScheduler::RemoveLODCamera(RenderCam const* cam) {
+	std::erase(lod_cameras, cam);
+}
+
+void TickScheduler::BeginFrame(Float32 dt) {
+	frame_clock.time += dt;
+	frame_clock.dt = dt;
+
+	// The active camera changes with the game state, so look it up every frame
+	RenderCam const* active_cam = p_graphics_manager ? p_graphics_manager->GetPActiveCam() : nullptr;
+
+	lod_views.clear();
+	if (active_cam) {
+		lod_views.push_back(LODView{ active_cam->GetViewProjMat(), active_cam->GetPosition() });
+	}
+	for (RenderCam const* cam : lod_cameras) {
+		if (cam != active_cam) {
+			lod_views.push_back(LODView{ cam->GetViewProjMat(), cam->GetPosition() });
+		}
+	}
+}
+
+void TickScheduler::BeginFixedStep(Float32 fixed_dt) noexcept {
+	fixed_clock.time += fixed_dt;
+	fixed_clock.dt = fixed_dt;
+}
+
+Bool TickScheduler::ShouldUpdate(Component& comp, Float32& dt) const noexcept {
+	return Tick(comp, frame_clock, comp.pending_dt, dt);
+}
+
+Bool TickScheduler::ShouldFixedUpdate(Component& comp, Float32& fixed_dt) const noexcept {
+	return Tick(comp, fixed_clock, comp.pending_fixed_dt, fixed_dt);
+}
+
+Bool TickScheduler::Tick(Component& comp, Clock const& clock, Float32& pending, Float32& dt) const noexcept {
+	GroupSettings const& settings = groups[static_cast<SizeT>(comp.tick_group)];
+	GameObject* owner = comp.GetOwner();
+
+	Float32 rate = settings.rate;
+	if (settings.lod_rate != settings.rate && not IsNear(owner, settings)) {
+		rate = settings.lod_rate;
+	}
+
+	// Tick when the object's phase-shifted clock crosses into a new period
+	if (rate != EVERY_FRAME) {
+		Float64 const phase = PhaseOf(owner);
+		Float64 const now = clock.time * rate + phase;
+		Float64 const before = (clock.time - clock.dt) * rate + phase;
+		if (std::floor(now) == std::floor(before)) {
+			pending += dt;
+			return false;
+		}
+	}
+
+	dt += pending;
+	pending = 0.0f;
+	return true;
+}
+
+Bool TickScheduler::IsNear(GameObject* obj, GroupSettings const& settings) const noexcept {
+	if (obj == nullptr || lod_views.empty()) { return true; }
+
+	// The Transform is relative to the parent, if there is one
+	Vec3 const position = Vec3(obj->GetWorldMat4()[3]);
+	Float32 const lod_distance2 = settings.lod_distance * settings.lod_distance;
+
+	for (LODView const& view : lod_views) {
+		if (settings.lod_distance > 0.0f && glm::distance2(view.position, position) > lod_distance2) {
+			continue;
+		}
+
+		Vec4 const clip = view.view_proj * Vec4(position, 1.0f);
+		Float32 const extent = clip.w * (1.0f + SCREEN_MARGIN);
+		if (clip.w > 0.0f && glm::abs(clip.x) <= extent && glm::abs(clip.y) <= extent) {
+			return true;
+		}
+	}
+	return false;
+}
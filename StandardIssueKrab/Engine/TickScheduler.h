@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Component.h"
+
+class RenderCam;
+
+/*
+* Decides when each component's Update and FixedUpdate run, from its
+* Component::TickGroup. A group has a rate for objects which some LOD camera
+* can see, and a (usually lower) LOD rate for objects which are off-screen or
+* farther than lod_distance from every LOD camera, e.g. AI at full rate on
+* screen and 10 Hz off it. The active render camera (GraphicsManager) is always
+* a LOD camera, and AddLODCamera adds extra ones, e.g. for split screen. With
+* no cameras every object counts as near.
+*
+* A component which skips updates builds up the time it skipped, and gets all
+* of it as dt in its next update. Ticks are spread over frames by giving each
+* object a stable phase from its handle: at 10 Hz and 60 fps, about a sixth of
+* a group's objects update on any frame instead of all of them every sixth.
+*
+* BeginFrame and BeginFixedStep advance the clocks and must be called once per
+* frame and per fixed step, before any component updates.
+*/
+class TickScheduler
+{
+public:
+	static constexpr Float32 EVERY_FRAME = 0.0f;
+
+	// Objects whose position is this far outside a camera's clip space, as a
+	// fraction of it, still count as on screen, since their bounds may not be
+	static constexpr Float32 SCREEN_MARGIN = 0.2f;
+
+	struct GroupSettings {
+		Float32 rate	     = EVERY_FRAME; // Hz, near and on screen
+		Float32 lod_rate     = EVERY_FRAME; // Hz, off-screen or far
+		Float32 lod_distance = 0.0f;		// 0 means only being off-screen counts
+	};
+
+private:
+	using GroupArray = Array<GroupSettings, static_cast<SizeT>(Component::TickGroup::Count)>;
+
+	// One clock for Update, one for FixedUpdate
+	struct Clock {
+		Float64 time = 0.0;
+		Float32 dt = 0.0f;
+	};
+
+	// A LOD camera (active or extra) as of the last BeginFrame
+	struct LODView {
+		Mat4 view_proj;
+		Vec3 position;
+	};
+
+	GroupArray				 groups;
+	Vector<RenderCam const*> lod_cameras;
+	Vector<LODView>			 lod_views;
+	Clock					 frame_clock;
+	Clock					 fixed_clock;
+
+public:
+	TickScheduler();
+
+	void SetGroupSettings(Component::TickGroup group, GroupSettings const& settings) noexcept;
+	GroupSettings const& GetGroupSettings(Component::TickGroup group) const noexcept;
+
+	// Extra cameras, besides the active one, used to tell if an object is on
+	// screen and near
+	void AddLODCamera(RenderCam const* cam);
+	void RemoveLODCamera(RenderCam const* cam);
+
+	void BeginFrame(Float32 dt);
+	void BeginFixedStep(Float32 fixed_dt) noexcept;
+
+	// True if comp updates now, in which case dt becomes the time since its
+	// last update. Otherwise the time is kept for later.
+	Bool ShouldUpdate(Component& comp, Float32& dt) const noexcept;
+	Bool ShouldFixedUpdate(Component& comp, Float32& fixed_dt) const noexcept;
+
+	// This frame's dt, for components which need to know how many frames the
+	// dt they were given covers
+	inline Float32 FrameDt() const noexcept { return frame_clock.dt; }
+
+private:
+	Bool Tick(Component& comp, Clock const& clock, Float32& pending, Float32& dt) const noexcept;
+	Bool IsNear(GameObject* obj, GroupSettings const& settings) const noexcept;
+};
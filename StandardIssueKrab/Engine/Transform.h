@@ -5,10 +5,22 @@ struct Transform {
 	Quat orientation = Quat(1,0,0,0);
 	Vec3 scale = Vec3(1);
 
+	// Composes the matrix on every call. Game objects' renderers use the
+	// cached GameObject::GetWorldMat4 instead.
 	inline Mat4 ToMat4() const {
 		return glm::translate(Mat4(1), position) * glm::toMat4(orientation) * glm::scale(Mat4(1), scale);
 	}
 
+	// Inverse of ToMat4. Shear, from a non-uniformly scaled parent rotating
+	// its child, cannot be kept and is dropped.
+	inline static Transform FromMat4(Mat4 const& m) {
+		Vec3 const scale{ glm::length(Vec3(m[0])), glm::length(Vec3(m[1])), glm::length(Vec3(m[2])) };
+		Mat3 const rotation{ Vec3(m[0]) / scale.x, Vec3(m[1]) / scale.y, Vec3(m[2]) / scale.z };
+		return Transform{ Vec3(m[3]), glm::normalize(glm::quat_cast(rotation)), scale };
+	}
+
+	bool operator==(Transform const&) const = default;
+
 	inline Vec3 EulerAngles() const{
 		return glm::eulerAngles(orientation);		
 	}
@@ -81,4 +93,19 @@ struct Transform {
 					glm::rotate(Quat(1, 0, 0, 0), yaw, Vec3(0, 0, 1));
 		orientation = quat;
 	}
+};
+
+/*
+* A game object's world matrix, cached by GameObjectManager::UpdateWorldMatrices.
+* Transforms are written directly all over the code, so a transform counts as
+* dirty when it differs from the copy its local matrix was composed from.
+*/
+struct WorldTransform {
+	Transform composed_from;
+	Mat4	  local = Mat4(1);
+	Mat4	  world = Mat4(1);	// parent's world * local
+	Mat4	  parent_world = Mat4(1);	// as of the last update, kept if the parent is deleted
+	Uint32	  frame = ~0u;		// of the last update, so parents update before their children
+	Bool	  valid = false;	// false until composed, or after the parent changes
+	Bool	  changed = false;	// world changed in the last update
 };
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "stdafx.h"
+#include "TransformBatch.h"
+
+#include "SIMD.h"
+#include "Transform.h"
+
+using namespace SIMD;
+
+static inline TransformBatch::Stream Offset(TransformBatch::Stream s, Uint32 k) {
+	return static_cast<TransformBatch::Stream>(static_cast<Uint32>(s) + k);
+}
+
+
+void TransformBatch::Resize(Uint32 _count) {
+	count = _count;
+	padded_count = (count + WIDTH - 1) / WIDTH * WIDTH;
+	data.assign(static_cast<SizeT>(COUNT) * padded_count, 0.0f);
+
+	// Identity orientation and unit scale in the padding lanes
+	std::fill(Get(QW) + count, Get(QW) + padded_count, 1.0f);
+	for (Uint32 k = 0; k < 3; ++k) {
+		std::fill(Get(Offset(SX, k)) + count, Get(Offset(SX, k)) + padded_count, 1.0f);
+	}
+}
+
+void TransformBatch::LoadTransform(Uint32 i, Transform const& tr) {
+	SIK_ASSERT(i < count, "Transform index out of range.");
+
+	for (Uint32 k = 0; k < 3; ++k) {
+		Get(Offset(PX, k))[i] = tr.position[k];
+		Get(Offset(SX, k))[i] = tr.scale[k];
+	}
+
+	Get(QW)[i] = tr.orientation.w;
+	Get(QX)[i] = tr.orientation.x;
+	Get(QY)[i] = tr.orientation.y;
+	Get(QZ)[i] = tr.orientation.z;
+}
+
+// Same matrix as glm::toMat4 for a unit quaternion, with each column scaled
+void TransformBatch::Compose() {
+	F4 const one = Splat(1.0f);
+	F4 const two = Splat(2.0f);
+
+	for (Uint32 i = 0; i < padded_count; i += WIDTH) {
+		F4 const qw = Load(Get(QW) + i);
+		F4 const qx = Load(Get(QX) + i);
+		F4 const qy = Load(Get(QY) + i);
+		F4 const qz = Load(Get(QZ) + i);
+
+		F4 const xx = Mul(qx, qx), yy = Mul(qy, qy), zz = Mul(qz, qz);
+		F4 const xy = Mul(qx, qy), xz = Mul(qx, qz), yz = Mul(qy, qz);
+		F4 const wx = Mul(qw, qx), wy = Mul(qw, qy), wz = Mul(qw, qz);
+
+		F4 const sx = Load(Get(SX) + i);
+		F4 const sy = Load(Get(SY) + i);
+		F4 const sz = Load(Get(SZ) + i);
+
+		Store(Get(C0X) + i, Mul(Sub(one, Mul(two, Add(yy, zz))), sx));
+		Store(Get(C0Y) + i, Mul(Mul(two, Add(xy, wz)), sx));
+		Store(Get(C0Z) + i, Mul(Mul(two, Sub(xz, wy)), sx));
+
+		Store(Get(C1X) + i, Mul(Mul(two, Sub(xy, wz)), sy));
+		Store(Get(C1Y) + i, Mul(Sub(one, Mul(two, Add(xx, zz))), sy));
+		Store(Get(C1Z) + i, Mul(Mul(two, Add(yz, wx)), sy));
+
+		Store(Get(C2X) + i, Mul(Mul(two, Add(xz, wy)), sz));
+		Store(Get(C2Y) + i, Mul(Mul(two, Sub(yz, wx)), sz));
+		Store(Get(C2Z) + i, Mul(Sub(one, Mul(two, Add(xx, yy))), sz));
+	}
+}
+
+void TransformBatch::StoreMatrix(Uint32 i, Mat4& out) const {
+	SIK_ASSERT(i < count, "Transform index out of range.");
+
+	for (Uint32 c = 0; c < 3; ++c) {
+		Stream const column = Offset(C0X, 3 * c);
+		out[c] = Vec4(Get(column)[i], Get(Offset(column, 1))[i], Get(Offset(column, 2))[i], 0.0f);
+	}
+	out[3] = Vec4(Get(PX)[i], Get(PY)[i], Get(PZ)[i], 1.0f);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+struct Transform;
+
+/*
+* Structure-of-arrays copy of the transforms whose matrices need rebuilding.
+* Compose turns position, orientation and scale into the affine part of a
+* world matrix 4 transforms at a time with SSE, writing the rotation-scale
+* columns directly instead of multiplying a translation, a rotation and a
+* scale matrix as Transform::ToMat4 does.
+*
+* Usage:
+*	batch.Resize(count);
+*	for each i: batch.LoadTransform(i, transform);
+*	batch.Compose();
+*	for each i: batch.StoreMatrix(i, matrix);
+*/
+class TransformBatch
+{
+public:
+	static constexpr Uint32 WIDTH = 4;
+
+	// One array per scalar. Each array is padded to a multiple of WIDTH.
+	enum Stream : Uint32 {
+		// Loaded
+		PX, PY, PZ, QW, QX, QY, QZ, SX, SY, SZ,
+
+		// Written by Compose: the three scaled rotation columns
+		C0X, C0Y, C0Z, C1X, C1Y, C1Z, C2X, C2Y, C2Z,
+
+		COUNT
+	};
+
+private:
+	Vector<Float32> data;
+	Uint32			count = 0;
+	Uint32			padded_count = 0;
+
+public:
+	// Makes room for count transforms. Padding lanes compose to identity.
+	void Resize(Uint32 count);
+
+	void LoadTransform(Uint32 i, Transform const& tr);
+	void Compose();
+	void StoreMatrix(Uint32 i, Mat4& out) const;
+
+	inline Uint32 Size() const noexcept { return count; }
+
+private:
+	inline Float32* Get(Stream s) noexcept { return data.data() + static_cast<SizeT>(s) * padded_count; }
+	inline Float32 const* Get(Stream s) const noexcept { return data.data() + static_cast<SizeT>(s) * padded_count; }
+};
@@ -2,6 +2,11 @@
 #include "FixedObjectPoolTest.h"
 
 #include "Engine/FixedObjectPool.h"
+#include "Engine/ChunkedObjectPool.h"
+#include "Engine/FrameTimer.h"
+#include "Engine/Handle.h"
+
+#include <execution>
 
 struct ThirtyTwoBytes
 {
@@ -329,6 +334,253 @@ static void test6() {
 	}
 }
 
+static void test7() {
+
+	// Growable pool: 1000 elements spread across chunks of 64
+	ChunkedObjectPool<ThirtyTwoBytes, 64> pool{};
+
+	std::vector<ThirtyTwoBytes*> ptrs{};
+	for (std::size_t i = 0; i < 1000; ++i) {
+		ptrs.push_back(pool.emplace(ThirtyTwoBytes{ .a = i * 3.14, .c = i }));
+	}
+	SIK_WARN("Inserted {} elements into {} chunks (capacity {})", pool.size(), pool.chunk_count(), pool.capacity());
+
+	// Erase every third element, including whole runs at chunk boundaries
+	for (std::size_t i = 0; i < ptrs.size(); i += 3) {
+		pool.erase(ptrs[i]);
+		ptrs[i] = nullptr;
+	}
+
+	std::size_t count = 0;
+	for (auto r = pool.all(); not r.is_empty(); r.pop_front()) {
+		if (r.front().c % 3 == 0) {
+			SIK_ERROR("Erased element {} was visited", r.front().c);
+		}
+		++count;
+	}
+	if (count != pool.size()) {
+		SIK_ERROR("Visited {} elements but size is {}", count, pool.size());
+	}
+
+	// Surviving pointers must still be valid
+	for (auto* p : ptrs) {
+		if (p != nullptr && p->a != p->c * 3.14) {
+			SIK_ERROR("Element {} moved or was overwritten", p->c);
+		}
+	}
+
+	// Refill the holes before any new chunk is allocated
+	std::size_t const chunks_before = pool.chunk_count();
+	for (std::size_t i = 0; i < 300; ++i) {
+		(void)pool.insert(ThirtyTwoBytes{});
+	}
+	SIK_WARN("Chunks before refill = {}, after = {}", chunks_before, pool.chunk_count());
+
+	// Erasing the front of a range while iterating must not skip or revisit
+	// elements, even when the erased slot joins a neighbouring skipblock
+	std::size_t const size_before = pool.size();
+	std::size_t visited = 0;
+	for (auto r = pool.all(); not r.is_empty(); r.pop_front()) {
+		++visited;
+		if (visited % 2 == 0 || r.front().c % 3 == 1) {
+			pool.erase(&r.front());
+		}
+	}
+	if (visited != size_before) {
+		SIK_ERROR("Visited {} elements while erasing, expected {}", visited, size_before);
+	}
+
+	// Empty chunks are only released by trim, which keeps one spare
+	for (auto r = pool.all(); not r.is_empty(); r.pop_front()) {
+		pool.erase(&r.front());
+	}
+	SIK_WARN("After erasing everything: chunks = {}, empty = {}", pool.chunk_count(), pool.empty_chunk_count());
+	pool.trim();
+	if (pool.chunk_count() != 1) {
+		SIK_ERROR("trim kept {} chunks, expected 1", pool.chunk_count());
+	}
+	pool.shrink_to_fit();
+	if (pool.chunk_count() != 0) {
+		SIK_ERROR("shrink_to_fit kept {} chunks", pool.chunk_count());
+	}
+
+	pool.clear();
+	SIK_WARN("After clear: size = {}, chunks = {}", pool.size(), pool.chunk_count());
+}
+
+static void test8() {
+
+	// Iterators, batch insert/erase and split must agree with the range API
+	auto p_fop = std::make_unique<FOP<ThirtyTwoBytes, 1000>>();
+
+	std::vector<ThirtyTwoBytes> src{};
+	for (std::size_t i = 0; i < 600; ++i) {
+		src.push_back(ThirtyTwoBytes{ .a = i * 3.14, .c = i });
+	}
+	std::size_t const inserted = p_fop->batch_insert(src.begin(), src.end());
+	if (inserted != src.size()) {
+		SIK_ERROR("batch_insert inserted {} of {} elements", inserted, src.size());
+	}
+
+	// Erase every third element in one batch
+	std::vector<ThirtyTwoBytes*> to_erase{};
+	for (auto&& elem : *p_fop) {
+		if (elem.c % 3 == 0) { to_erase.push_back(&elem); }
+	}
+	std::size_t const erased = p_fop->batch_erase(to_erase.begin(), to_erase.end());
+	SIK_WARN("batch_erase erased {} elements, {} left", erased, p_fop->size());
+
+	if (std::any_of(p_fop->begin(), p_fop->end(), [](ThirtyTwoBytes const& e) { return e.c % 3 == 0; })) {
+		SIK_ERROR("Erased element was visited by the iterators");
+	}
+	std::size_t const iterated = static_cast<std::size_t>(std::distance(p_fop->begin(), p_fop->end()));
+	if (iterated != p_fop->size()) {
+		SIK_ERROR("Iterated {} elements but size is {}", iterated, p_fop->size());
+	}
+
+	// Refill the holes, which fills whole skipblocks at a time
+	p_fop->batch_insert(200, ThirtyTwoBytes{ .c = 1 });
+
+	std::array<FOP<ThirtyTwoBytes, 1000>::range, 7> parts{};
+	p_fop->split(parts.size(), parts.begin());
+	std::size_t split_count = 0;
+	for (auto&& part : parts) {
+		for (auto&& elem : part) {
+			(void)elem;
+			++split_count;
+		}
+	}
+	if (split_count != p_fop->size()) {
+		SIK_ERROR("Split ranges visited {} elements but size is {}", split_count, p_fop->size());
+	}
+}
+
+static void test9() {
+
+	// Benchmarks: the range path against iterators, batches and split
+	static constexpr std::size_t N = 60000;
+	auto p_fop = std::make_unique<FOP<ThirtyTwoBytes, N>>();
+	std::vector<ThirtyTwoBytes*> ptrs{};
+	ptrs.reserve(N);
+
+	{
+		SIK_TIMER("FOP: insert 60000 one at a time");
+		for (std::size_t i = 0; i < N; ++i) {
+			ptrs.push_back(p_fop->insert(ThirtyTwoBytes{ .c = i }));
+		}
+	}
+	{
+		SIK_TIMER("FOP: erase every other element one at a time");
+		for (std::size_t i = 0; i < N; i += 2) {
+			p_fop->erase(ptrs[i]);
+		}
+	}
+	{
+		SIK_TIMER("FOP: refill holes one at a time");
+		for (std::size_t i = 0; i < N / 2; ++i) {
+			(void)p_fop->insert(ThirtyTwoBytes{ .c = i });
+		}
+	}
+	p_fop->clear();
+
+	std::vector<ThirtyTwoBytes> src(N, ThirtyTwoBytes{ .a = 1.0 });
+	{
+		SIK_TIMER("FOP: batch_insert 60000");
+		p_fop->batch_insert(src.begin(), src.end());
+	}
+	ptrs.clear();
+	for (auto&& elem : *p_fop) {
+		ptrs.push_back(&elem);
+	}
+	std::vector<ThirtyTwoBytes*> every_other{};
+	for (std::size_t i = 0; i < N; i += 2) {
+		every_other.push_back(ptrs[i]);
+	}
+	{
+		SIK_TIMER("FOP: batch_erase every other element");
+		p_fop->batch_erase(every_other.begin(), every_other.end());
+	}
+	{
+		SIK_TIMER("FOP: batch_insert to refill holes");
+		p_fop->batch_insert(N / 2, ThirtyTwoBytes{ .a = 1.0 });
+	}
+
+	double sum = 0.0;
+	{
+		SIK_TIMER("FOP: iterate with all()/pop_front");
+		for (auto r = p_fop->all(); not r.is_empty(); r.pop_front()) {
+			sum += r.front().a;
+		}
+	}
+	{
+		SIK_TIMER("FOP: iterate with iterators");
+		for (auto&& elem : *p_fop) {
+			sum += elem.a;
+		}
+	}
+	{
+		SIK_TIMER("FOP: std::for_each over split(8), parallel");
+		std::array<FOP<ThirtyTwoBytes, N>::range, 8> parts{};
+		p_fop->split(parts.size(), parts.begin());
+		std::for_each(std::execution::par, parts.begin(), parts.end(), [](auto part) {
+			for (auto&& elem : part) {
+				elem.b = elem.a * 2.0;
+			}
+		});
+	}
+	SIK_WARN("Checksum {}", sum);
+}
+
+static void test10() {
+
+	// Compaction through handles: churn a pool, compact it, and check every
+	// handle still resolves to its element while stale ones resolve to nothing
+	ChunkedObjectPool<ThirtyTwoBytes, 64> pool{};
+	HandleTable<ThirtyTwoBytes> handles{};
+	std::vector<Handle<ThirtyTwoBytes>> live{};
+	std::vector<Handle<ThirtyTwoBytes>> stale{};
+
+	for (std::size_t i = 0; i < 2000; ++i) {
+		ThirtyTwoBytes* p = pool.emplace(ThirtyTwoBytes{ .c = i });
+		Handle<ThirtyTwoBytes> const h = handles.Create(p);
+		p->d = h.handle; // elements know their own handle, like MeshRenderer::handle
+		live.push_back(h);
+	}
+
+	// Keep one element in eight, spread across every chunk
+	std::erase_if(live, [&](Handle<ThirtyTwoBytes> h) {
+		ThirtyTwoBytes* p = handles.Resolve(h);
+		if (p->c % 8 == 0) { return false; }
+		handles.Release(h);
+		pool.erase(p);
+		stale.push_back(h);
+		return true;
+	});
+
+	std::size_t const chunks_before = pool.chunk_count();
+	std::size_t const moved = pool.compact([&](ThirtyTwoBytes*, ThirtyTwoBytes* to) {
+		Handle<ThirtyTwoBytes> h{};
+		h.handle = static_cast<Uint32>(to->d);
+		handles.Relocate(h, to);
+	});
+	SIK_WARN("Compaction moved {} elements, chunks {} -> {}", moved, chunks_before, pool.chunk_count());
+
+	if (pool.chunk_count() != (pool.size() + 63) / 64) {
+		SIK_ERROR("Pool is not dense after compaction: {} chunks for {} elements", pool.chunk_count(), pool.size());
+	}
+	for (auto h : live) {
+		ThirtyTwoBytes const* p = handles.Resolve(h);
+		if (p == nullptr || p->c % 8 != 0 || p->d != h.handle) {
+			SIK_ERROR("Live handle {} resolved to the wrong element", h.handle);
+		}
+	}
+	for (auto h : stale) {
+		if (handles.Resolve(h) != nullptr) {
+			SIK_ERROR("Stale handle {} still resolves", h.handle);
+		}
+	}
+}
+
 struct FOPTest {
 	int num;
 	decltype(&test0) test;
@@ -341,7 +593,11 @@ static FOPTest pTests[] = {
 	{ 3, test3 },
 	{ 4, test4 },
 	{ 5, test5 },
-	{ 6, test6 }
+	{ 6, test6 },
+	{ 7, test7 },
+	{ 8, test8 },
+	{ 9, test9 },
+	{ 10, test10 }
 };
 
 
@@ -3,14 +3,53 @@
 
 #include "Engine/MemoryResources.h"
 #include "Engine/GameObject.h"
+#include "Engine/GameObjectManager.h"
 #include "Engine/Component.h"
 #include "Engine/Serializer.h"
 #include "Engine/TestComp.h"
+#include "Engine/FrameTimer.h"
+#include "Engine/TickScheduler.h"
+#include "Engine/QueryBatch.h"
 
 
 // TODO (bug) : this test leaks 200 bytes. So does SerializeTest (264 bytes) and
 // ScriptTest (120 bytes. Maybe they're related...
 
+// Only overridden callbacks are called on a component
+static_assert(OverriddenPhases<TestComp>() == Component::PHASE_NONE);
+static_assert(OverriddenPhases<TestComp2>() == Component::PHASE_ON_COLLIDE);
+
+// Types which don't declare their access are kept on the main thread
+static_assert(DeclaredAccess<TestComp>() == Component::ACCESS_MAIN_THREAD);
+static_assert(DeclaredAccess<TestReaderComp>() == Component::ACCESS_READ_OTHER_TRANSFORMS);
+
+// Stand-in for a game component of any type, so the lookup benchmark can fill
+// an object with as many types as the component lists have
+template<Component::Type T>
+class BenchComp final : public Component {
+public:
+	static constexpr Component::Type type{ T };
+	constexpr Component::Type GetType() const override { return type; }
+	constexpr SizeT GetSize() const override { return sizeof(BenchComp); }
+	constexpr SizeT GetAlignment() const override { return alignof(BenchComp); }
+	constexpr Uint8 GetPhases() const override { return OverriddenPhases<BenchComp>(); }
+	void Deserialize(rapidjson::Value const&) override {}
+	void Serialize(rapidjson::Value&, rapidjson::MemoryPoolAllocator<>&) override {}
+};
+
+template<SizeT... Is>
+static void AddBenchComps(GameObject& go, PolymorphicAllocator alloc, std::index_sequence<Is...>) {
+	(go.AddComponent(alloc.new_object<BenchComp<static_cast<Component::Type>(Is)>>()), ...);
+}
+
+// The scan HasComponent did before the type mask and slot table
+static Component* LinearHasComponent(GameObject const& go, Component::Type comp_type) {
+	auto const& components = go.GetComponentArray();
+	auto it = std::find_if(components.begin(), components.end(),
+		[comp_type](UniquePtr<Component> const& comp) { return comp->GetType() == comp_type; });
+	return it != components.end() ? it->get() : nullptr;
+}
+
 void GOandCompTest::Setup(EngineExport* p_engine_export_struct) {
 #ifdef STR_DEBUG
 	p_dbg_string_dictionary = p_engine_export_struct->p_dbg_string_dictionary;
@@ -80,6 +119,460 @@ void GOandCompTest::Run() {
 		}
 	}
 
+	// HasComponent microbenchmark: every type of a 10-component object,
+	// looked up many times, against the old linear scan
+	{
+		static constexpr SizeT NUM_BENCH_COMPS = 10;
+		static constexpr Uint32 ITERATIONS = 1'000'000;
+		static_assert(Component::NUM_COMPONENTS >= NUM_BENCH_COMPS, "Not enough component types to benchmark.");
+
+		GameObject go{ "Bench Object", alloc };
+		AddBenchComps(go, alloc, std::make_index_sequence<NUM_BENCH_COMPS>{});
+
+		for (SizeT t = 0; t < Component::NUM_COMPONENTS; ++t) {
+			Component::Type const type = static_cast<Component::Type>(t);
+			if (go.HasComponent(type) != LinearHasComponent(go, type)) {
+				SIK_ERROR("HasComponent disagrees with a linear scan for type {}.", t);
+				SetFailed();
+				return;
+			}
+		}
+
+		// Summed so the lookups are not optimized out
+		Uint64 found_linear = 0;
+		Uint64 found_mask = 0;
+		{
+			SIK_TIMER("HasComponent: linear scan, 10 components");
+			for (Uint32 i = 0; i < ITERATIONS; ++i) {
+				Component::Type const type = static_cast<Component::Type>(i % NUM_BENCH_COMPS);
+				found_linear += reinterpret_cast<Uint64>(LinearHasComponent(go, type));
+			}
+		}
+		{
+			SIK_TIMER("HasComponent: mask and slot table, 10 components");
+			for (Uint32 i = 0; i < ITERATIONS; ++i) {
+				Component::Type const type = static_cast<Component::Type>(i % NUM_BENCH_COMPS);
+				found_mask += reinterpret_cast<Uint64>(go.HasComponent(type));
+			}
+		}
+		if (found_linear != found_mask) {
+			SIK_ERROR("HasComponent found different components than a linear scan.");
+			SetFailed();
+			return;
+		}
+	}
+
+	// Component storage: components of one type share a column, and go back
+	// to it when their object is deleted
+	{
+		ComponentStorage& storage = p_game_obj_manager->GetComponentStorage();
+		SizeT const count_before = storage.Count(TestComp2::type);
+
+		Array<GameObject*, 3> objs;
+		for (GameObject*& obj : objs) {
+			obj = p_game_obj_manager->CreateGameObject("Storage Test");
+			obj->AddComponent(storage.Create<TestComp2>());
+		}
+
+		SizeT visited = 0;
+		storage.ForEach<TestComp2>([&visited](TestComp2&) { ++visited; });
+		if (storage.Count(TestComp2::type) != count_before + objs.size() || visited != count_before + objs.size()) {
+			SIK_ERROR("Component storage did not hold every created component.");
+			SetFailed();
+			return;
+		}
+		if (objs[1]->HasComponent<TestComp2>() == nullptr) {
+			SIK_ERROR("HasComponent did not find a component from the storage.");
+			SetFailed();
+			return;
+		}
+
+		// Deferred commands run in order, along with the ones they defer
+		Vector<Uint32> order;
+		p_game_obj_manager->Defer([&order] {
+			order.push_back(0);
+			p_game_obj_manager->Defer([&order] { order.push_back(2); });
+		});
+		p_game_obj_manager->Defer([&order] { order.push_back(1); });
+		storage.RunDeferred();
+		if (order != Vector<Uint32>{ 0, 1, 2 }) {
+			SIK_ERROR("Deferred commands did not all run in the order they were deferred.");
+			SetFailed();
+			return;
+		}
+
+		for (GameObject* obj : objs) {
+			p_game_obj_manager->DeleteGameObject(obj);
+		}
+		p_game_obj_manager->CleanupDeletedObjects();
+		if (storage.Count(TestComp2::type) != count_before) {
+			SIK_ERROR("Deleted objects did not give their components back to the storage.");
+			SetFailed();
+			return;
+		}
+	}
+
+	// Component batches: over a list of objects, a type which conflicts with
+	// the batch before it waits for the whole batch, deferred commands run
+	// before the next type, and unsafe types run on the main thread. Objects
+	// not in the list are left alone.
+	{
+		static constexpr Uint32 num_objs = 100; // enough for the parallel algorithm
+
+		TickScheduler scheduler;
+		scheduler.BeginFrame(1.0f / 60.0f);
+		ComponentStorage& storage = p_game_obj_manager->GetComponentStorage();
+
+		Vector<GameObject*> objs;
+		for (Uint32 i = 0; i < num_objs + 1; ++i) {
+			GameObject* obj = p_game_obj_manager->CreateGameObject("Batch Test");
+			obj->AddComponent(storage.Create<TestWriterComp>());
+			obj->AddComponent(storage.Create<TestReaderComp>());
+			obj->AddComponent(storage.Create<TestMainThreadComp>());
+			objs.push_back(obj);
+		}
+		GameObject* left_out = objs.back();
+		objs.pop_back();
+
+		test_update_counter = 0;
+		storage.Update(objs, 1.0f / 60.0f, scheduler);
+
+		Uint32 last_writer = 0, first_reader = ~0u, last_reader = 0;
+		Uint32 first_deferred = ~0u, last_deferred = 0, first_main = ~0u;
+		Bool all_once = true, writers_parallel = true, readers_parallel = true, main_on_main = true;
+		std::thread::id const main_thread = std::this_thread::get_id();
+		for (GameObject* obj : objs) {
+			TestUpdateRecord const& writer = obj->HasComponent<TestWriterComp>()->record;
+			TestReaderComp const& reader = *obj->HasComponent<TestReaderComp>();
+			TestUpdateRecord const& main = obj->HasComponent<TestMainThreadComp>()->record;
+
+			all_once = all_once && writer.updates == 1 && reader.record.updates == 1 && main.updates == 1;
+			writers_parallel = writers_parallel && writer.in_parallel_job;
+			readers_parallel = readers_parallel && reader.record.in_parallel_job;
+			main_on_main = main_on_main && not main.in_parallel_job && main.thread == main_thread;
+
+			last_writer = std::max(last_writer, writer.order);
+			first_reader = std::min(first_reader, reader.record.order);
+			last_reader = std::max(last_reader, reader.record.order);
+			first_deferred = std::min(first_deferred, reader.deferred_order);
+			last_deferred = std::max(last_deferred, reader.deferred_order);
+			first_main = std::min(first_main, main.order);
+		}
+		Bool const left_alone = left_out->HasComponent<TestWriterComp>()->record.updates == 0
+			&& left_out->HasComponent<TestMainThreadComp>()->record.updates == 0;
+
+		for (GameObject* obj : objs) {
+			p_game_obj_manager->DeleteGameObject(obj);
+		}
+		p_game_obj_manager->DeleteGameObject(left_out);
+		p_game_obj_manager->CleanupDeletedObjects();
+
+		if (not all_once || not left_alone) {
+			SIK_ERROR("A batched sweep did not update exactly the listed objects' components once.");
+			SetFailed();
+			return;
+		}
+		if (not writers_parallel || not readers_parallel || not main_on_main) {
+			SIK_ERROR("Component types did not run where their declared access allows.");
+			SetFailed();
+			return;
+		}
+		if (last_writer > first_reader || last_reader > first_deferred || last_deferred > first_main) {
+			SIK_ERROR("Conflicting types or deferred commands overlapped: writers to {}, readers {} to {}, deferred {} to {}, main thread from {}.",
+				last_writer, first_reader, last_reader, first_deferred, last_deferred, first_main);
+			SetFailed();
+			return;
+		}
+	}
+
+	// Name and tag index: lookups follow renames and retags, and skip deleted
+	// objects right away
+	{
+		GameObject* first = p_game_obj_manager->CreateGameObject("Index Test A");
+		GameObject* second = p_game_obj_manager->CreateGameObject("Index Test B");
+		first->AddTag("IndexTest"_sid);
+		second->AddTag("IndexTest"_sid);
+		second->AddTag("IndexTest"_sid);
+
+		SizeT tagged = 0;
+		p_game_obj_manager->ForEachWithTag("IndexTest"_sid, [&tagged](GameObject&) { ++tagged; });
+		if (p_game_obj_manager->FindByName("Index Test A") != first || tagged != 2) {
+			SIK_ERROR("The name and tag index did not find the created objects.");
+			SetFailed();
+			return;
+		}
+
+		first->SetName("Index Test C");
+		second->RemoveTag("IndexTest"_sid);
+		p_game_obj_manager->DeleteGameObject(second);
+
+		tagged = 0;
+		p_game_obj_manager->ForEachWithTag("IndexTest"_sid, [&tagged](GameObject&) { ++tagged; });
+		if (p_game_obj_manager->FindByName("Index Test A") != nullptr
+			|| p_game_obj_manager->FindByName("Index Test C") != first
+			|| p_game_obj_manager->FindByName("Index Test B") != nullptr
+			|| tagged != 1) {
+			SIK_ERROR("The name and tag index missed a rename, a retag or a deletion.");
+			SetFailed();
+			return;
+		}
+
+		p_game_obj_manager->DeleteGameObject(first);
+		p_game_obj_manager->CleanupDeletedObjects();
+	}
+
+	// World matrices: the batch composes what ToMat4 does, children follow
+	// their parent, and a deleted parent leaves its child in world space
+	{
+		auto near_equal = [](Mat4 const& a, Mat4 const& b) {
+			for (Uint32 c = 0; c < 4; ++c) {
+				if (glm::any(glm::greaterThan(glm::abs(a[c] - b[c]), Vec4(1.0e-4f)))) { return false; }
+			}
+			return true;
+		};
+
+		GameObject* parent = p_game_obj_manager->CreateGameObject("World Test Parent");
+		GameObject* child = p_game_obj_manager->CreateGameObject("World Test Child");
+		Transform* parent_tr = parent->HasComponent<Transform>();
+		Transform* child_tr = child->HasComponent<Transform>();
+		parent_tr->position = Vec3(1.0f, 2.0f, 3.0f);
+		parent_tr->orientation = glm::angleAxis(0.7f, glm::normalize(Vec3(1.0f, 2.0f, 0.5f)));
+		parent_tr->scale = Vec3(2.0f, 1.0f, 0.5f);
+		child_tr->position = Vec3(0.0f, 1.0f, 0.0f);
+		child->SetParent(parent);
+
+		p_game_obj_manager->UpdateWorldMatrices();
+		if (not near_equal(parent->GetWorldMat4(), parent_tr->ToMat4())
+			|| not near_equal(child->GetWorldMat4(), parent_tr->ToMat4() * child_tr->ToMat4())) {
+			SIK_ERROR("Cached world matrices do not match the composed transforms.");
+			SetFailed();
+			return;
+		}
+
+		parent_tr->position.x += 5.0f;
+		p_game_obj_manager->UpdateWorldMatrices();
+		if (not near_equal(child->GetWorldMat4(), parent_tr->ToMat4() * child_tr->ToMat4())) {
+			SIK_ERROR("A child's world matrix did not follow its moved parent.");
+			SetFailed();
+			return;
+		}
+
+		// Uniformly scaled, so the child's world matrix has no shear to drop
+		parent_tr->scale = Vec3(2.0f);
+		p_game_obj_manager->UpdateWorldMatrices();
+		Mat4 const child_world = child->GetWorldMat4();
+
+		p_game_obj_manager->DeleteGameObject(parent);
+		p_game_obj_manager->UpdateWorldMatrices();
+		if (child->GetParent() || not near_equal(child->GetWorldMat4(), child_world)
+			|| not near_equal(child_tr->ToMat4(), child_world)) {
+			SIK_ERROR("A deleted parent's child was not left in place in world space.");
+			SetFailed();
+			return;
+		}
+
+		p_game_obj_manager->DeleteGameObject(child);
+		p_game_obj_manager->CleanupDeletedObjects();
+	}
+
+	// Recycle pools: a deleted object of a pooled archetype comes back, moved
+	// to its spawn pose and with a new handle, and the pool keeps its limit
+	{
+		StringID const archetype = "RecycleTest.json"_sid;
+		p_game_obj_manager->SetRecycleLimit(archetype, 1);
+
+		GameObject* first = p_game_obj_manager->CreateGameObject("Recycle Test");
+		p_game_obj_manager->SetArchetype(first, archetype);
+		first->HasComponent<Transform>()->position = Vec3(4.0f, 0.0f, 0.0f);
+		GameObject* second = p_game_obj_manager->CreateGameObject("Recycle Test");
+		p_game_obj_manager->SetArchetype(second, archetype);
+
+		GameObjectHandle const old_handle = first->GetHandle();
+		p_game_obj_manager->DeleteGameObject(first);
+		p_game_obj_manager->DeleteGameObject(second);
+		if (p_game_obj_manager->RecycledCount(archetype) != 1 || p_game_obj_manager->DeleteGameObject(first)) {
+			SIK_ERROR("The recycle pool did not keep exactly one deleted object.");
+			SetFailed();
+			return;
+		}
+
+		GameObject* reused = p_game_obj_manager->TakeRecycled(archetype);
+		if (reused != first || not reused->IsActive()
+			|| p_game_obj_manager->Resolve(old_handle) != nullptr
+			|| p_game_obj_manager->Resolve(reused->GetHandle()) != reused
+			|| reused->HasComponent<Transform>()->position != Vec3(0.0f)) {
+			SIK_ERROR("A recycled object was not handed back as a new object in its spawn pose.");
+			SetFailed();
+			return;
+		}
+
+		p_game_obj_manager->SetRecycleLimit(archetype, 0);
+		p_game_obj_manager->DeleteGameObject(reused);
+		p_game_obj_manager->CleanupDeletedObjects();
+	}
+
+	// Recycle pools: an object built before its archetype got a limit is
+	// still reused in the spawn pose it was built in
+	{
+		StringID const archetype = "RecycleLateTest.json"_sid;
+
+		GameObject* early = p_game_obj_manager->CreateGameObject("Recycle Late Test");
+		p_game_obj_manager->SetArchetype(early, archetype);
+		p_game_obj_manager->SetRecycleLimit(archetype, 1);
+		early->HasComponent<Transform>()->position = Vec3(0.0f, 7.0f, 0.0f);
+		p_game_obj_manager->DeleteGameObject(early);
+
+		GameObject* reused = p_game_obj_manager->TakeRecycled(archetype);
+		if (reused != early || reused->HasComponent<Transform>()->position != Vec3(0.0f)) {
+			SIK_ERROR("An object built before its archetype was pooled kept its old pose when reused.");
+			SetFailed();
+			return;
+		}
+
+		p_game_obj_manager->SetRecycleLimit(archetype, 0);
+		p_game_obj_manager->DeleteGameObject(reused);
+		p_game_obj_manager->CleanupDeletedObjects();
+	}
+
+	// Tick groups: a 10 Hz group updates 10 times in a little over a second at
+	// 60 fps, and the skipped time is handed over in dt
+	{
+		TickScheduler scheduler;
+		scheduler.SetGroupSettings(Component::TickGroup::Ambient, { .rate = 10.0f, .lod_rate = 10.0f });
+
+		TestComp comp;
+		comp.SetTickGroup(Component::TickGroup::Ambient);
+
+		Uint32 updates = 0;
+		Float32 total_dt = 0.0f;
+		for (Uint32 frame = 0; frame < 61; ++frame) {
+			Float32 dt = 1.0f / 60.0f;
+			scheduler.BeginFrame(dt);
+			if (scheduler.ShouldUpdate(comp, dt)) {
+				++updates;
+				total_dt += dt;
+			}
+		}
+		if (updates != 10 || glm::abs(total_dt - 1.0f) > 1.0f / 60.0f + 1.0e-3f) {
+			SIK_ERROR("A 10 Hz tick group updated {} times over {}s instead of 10 times over about 1s.", updates, total_dt);
+			SetFailed();
+			return;
+		}
+	}
+
+	// Tick phases: objects in a 10 Hz group at 60 fps are spread over the
+	// frames, about a sixth of them on each, instead of all on the same frame
+	{
+		static constexpr Uint32 num_objs = 60;
+
+		TickScheduler scheduler;
+		scheduler.SetGroupSettings(Component::TickGroup::Ambient, { .rate = 10.0f, .lod_rate = 10.0f });
+
+		ComponentStorage& storage = p_game_obj_manager->GetComponentStorage();
+		Array<GameObject*, num_objs> objs;
+		for (GameObject*& obj : objs) {
+			obj = p_game_obj_manager->CreateGameObject("Tick Phase Test");
+			TestComp* comp = storage.Create<TestComp>();
+			comp->SetTickGroup(Component::TickGroup::Ambient);
+			obj->AddComponent(comp);
+		}
+
+		Uint32 busiest_frame = 0;
+		Array<Uint32, num_objs> updates{};
+		for (Uint32 frame = 0; frame < 60; ++frame) {
+			scheduler.BeginFrame(1.0f / 60.0f);
+
+			Uint32 this_frame = 0;
+			for (Uint32 i = 0; i < num_objs; ++i) {
+				Float32 dt = 1.0f / 60.0f;
+				if (scheduler.ShouldUpdate(*objs[i]->HasComponent<TestComp>(), dt)) {
+					++updates[i];
+					++this_frame;
+				}
+			}
+			busiest_frame = std::max(busiest_frame, this_frame);
+		}
+
+		for (GameObject* obj : objs) {
+			p_game_obj_manager->DeleteGameObject(obj);
+		}
+		p_game_obj_manager->CleanupDeletedObjects();
+
+		auto const [fewest, most] = std::minmax_element(updates.begin(), updates.end());
+		if (busiest_frame > num_objs / 3 || *fewest < 9 || *most > 11) {
+			SIK_ERROR("Tick phases were not spread: {} of {} objects on one frame, {} to {} updates each.",
+				busiest_frame, num_objs, *fewest, *most);
+			SetFailed();
+			return;
+		}
+	}
+
+	// Query batches: every query in a batch big enough to run in parallel finds
+	// the same bodies as when it runs alone, and as a scan over every body
+	{
+		using namespace Collision;
+
+		static constexpr Uint32 grid = 8;
+		Vector<RigidBody> bodies(grid * grid);
+		BVHierarchy bvh;
+		for (Uint32 i = 0; i < grid * grid; ++i) {
+			RigidBody& rb = bodies[i];
+			rb.position = Vec3(3.0f * (i % grid), 0.0f, 3.0f * (i / grid));
+			rb.bounds = AABB{ .position = rb.position, .halfwidths = Vec3(0.5f + 0.25f * (i % 3)) };
+			rb.layer = i % 2;
+			bvh.Insert(rb.bounds, &rb);
+		}
+
+		// The first 12 queries are spheres and the rest boxes. Odd queries only
+		// look at layer 1.
+		static constexpr Uint32 num_queries = 24;
+		auto center = [](Uint32 i) { return Vec3(2.1f * i, 0.5f, 1.3f * i); };
+		auto radius = [](Uint32 i) { return 2.0f + 0.5f * i; };
+		auto box = [&center](Uint32 i) { return AABB{ .position = center(i), .halfwidths = Vec3(0.5f * (i - 10)) }; };
+		auto mask = [](Uint32 i) { return (i % 2) ? RigidBody::LayerBit(1) : QueryBatch::ALL_LAYERS; };
+		auto add_query = [&](QueryBatch& to, Uint32 i) {
+			if (i < 12) { to.AddSphere(center(i), radius(i), mask(i)); }
+			else { to.AddBox(box(i), mask(i)); }
+		};
+
+		QueryBatch batch;
+		for (Uint32 i = 0; i < num_queries; ++i) {
+			add_query(batch, i);
+		}
+		batch.Run(bvh);
+
+		auto sorted = [](std::span<QueryBatch::Hit const> hits) {
+			Vector<RigidBody const*> out;
+			for (QueryBatch::Hit const& hit : hits) { out.push_back(hit.body); }
+			std::sort(out.begin(), out.end());
+			return out;
+		};
+
+		for (Uint32 i = 0; i < num_queries; ++i) {
+			QueryBatch alone;
+			add_query(alone, i);
+			alone.Run(bvh);
+
+			Vector<RigidBody const*> scanned;
+			for (RigidBody const& rb : bodies) {
+				if ((mask(i) & RigidBody::LayerBit(rb.layer)) == 0) { continue; }
+				Bool const hit = (i < 12)
+					? rb.bounds.DistSquaredFromPoint(center(i)) < radius(i) * radius(i)
+					: rb.bounds.Intersects(box(i));
+				if (hit) { scanned.push_back(&rb); }
+			}
+			std::sort(scanned.begin(), scanned.end());
+
+			Vector<RigidBody const*> const batched = sorted(batch.Hits(i));
+			if (batched != sorted(alone.Hits(0)) || batched != scanned) {
+				SIK_ERROR("Query {} found {} bodies in a batch, {} alone and {} by a scan.",
+					i, batched.size(), alone.Hits(0).size(), scanned.size());
+				SetFailed();
+				return;
+			}
+		}
+	}
+
 	SetPassed();
 }
 
@@ -94,7 +94,7 @@ void GameObjectTest::Setup(EngineExport* _p_engine_export_struct) {
 	tr = s2->HasComponent<Transform>();
 	SIK_ASSERT(tr != nullptr, "GO 2 must have Transform");
 
-	s2->AddComponent(new TestComp2());
+	s2->AddComponent(p_game_obj_manager->GetComponentStorage().Create<TestComp2>());
 
 	controlled = s2;
 
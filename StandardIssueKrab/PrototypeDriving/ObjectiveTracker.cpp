@@ -64,18 +64,8 @@ void ObjectiveTracker::Update(Float32 dt) {
 
 	if (m_player == nullptr)
 	{
-		// Find player
-		auto& go_container = p_game_obj_manager->GetGameObjectContainer();
-		for (auto r = go_container.all(); not r.is_empty(); r.pop_front()) {
-			GameObject& game_obj = r.front();
-			if (game_obj.GetName() == "PlayerObj")
-			{
-				m_player = &game_obj;
-				return; // return and update next update call
-			}
-		}
-		
-		// if not found, return
+		// Find player, and update next update call
+		m_player = p_game_obj_manager->FindByName("PlayerObj"_sid);
 		return;
 	}
 
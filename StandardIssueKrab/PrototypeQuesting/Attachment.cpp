@@ -20,14 +20,7 @@ void Attachment::Deserialize(rapidjson::Value const& json_value) {
 	String name = it->value.GetString();
 
 	// find game object with matching name
-	auto& game_objs = p_game_obj_manager->GetGameObjectContainer();
-	for (auto range = game_objs.all(); !range.is_empty(); range.pop_front()) {
-		GameObject& game_obj = range.front();
-		if (game_obj.GetName() == name) {
-			p_attached_to = &game_obj;
-			break;
-		}
-	}
+	p_attached_to = p_game_obj_manager->FindByName(name.c_str());
 }
 
 void Attachment::Serialize(rapidjson::Value& json_value, rapidjson::MemoryPoolAllocator<>& alloc) {
@@ -10,7 +10,8 @@ Enemy::Enemy():
 	player_obj{ nullptr },
 	p_turret{ nullptr }
 {
-
+	// Chasing and aiming can run at a lower rate while off-screen
+	SetTickGroup(TickGroup::AI);
 }
 
 void Enemy::Deserialize(rapidjson::Value const& json_value) {
@@ -13,6 +13,7 @@ public:
 
 public:
 	VALID_COMPONENT(Enemy);
+	static constexpr Uint16 access = ACCESS_READ_RIGIDBODY | ACCESS_WRITE_RIGIDBODY | ACCESS_READ_OTHER_TRANSFORMS;
 
 	Enemy();
 	~Enemy() noexcept = default;